@@ -0,0 +1,159 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "adaptive_debounce.h"
+#include "debounce.h"
+#include "timer.h"
+#include "print.h"
+
+#define KKB_DEBOUNCE_KEYS (MATRIX_ROWS * MATRIX_COLS)
+
+// Per-key debounce state
+static uint8_t debounce_countdown[KKB_DEBOUNCE_KEYS]; // Remaining ms of the window, 0 = idle
+static uint8_t debounce_span[KKB_DEBOUNCE_KEYS];      // ms since the window started
+static uint8_t debounce_clean[KKB_DEBOUNCE_KEYS];     // Clean changes in a row
+static bool    debounce_bounced[KKB_DEBOUNCE_KEYS];   // Window had a bounce
+
+// Per-key statistics (debounce_ms is also the key's current debounce time)
+static kkb_debounce_stats_t debounce_stats[KKB_DEBOUNCE_KEYS];
+
+static matrix_row_t last_raw[MATRIX_ROWS];
+static uint16_t     last_time;
+static bool         windows_active = false;
+
+static inline uint8_t saturating_add(uint8_t a, uint16_t b) {
+    return (a + b > UINT8_MAX) ? UINT8_MAX : (uint8_t)(a + b);
+}
+
+// Adapt the key's debounce time at the end of a window
+static void adapt_debounce_time(uint8_t index) {
+    kkb_debounce_stats_t *stats = &debounce_stats[index];
+
+    if (debounce_bounced[index]) {
+        debounce_clean[index] = 0;
+        if (stats->debounce_ms < KKB_DEBOUNCE_MAX) {
+            stats->debounce_ms++;
+        }
+    } else if (++debounce_clean[index] >= KKB_DEBOUNCE_CLEAN_STEPS) {
+        debounce_clean[index] = 0;
+        if (stats->debounce_ms > KKB_DEBOUNCE_MIN) {
+            stats->debounce_ms--;
+        }
+    }
+}
+
+// QMK: Debounce init
+void debounce_init(uint8_t num_rows) {
+    for (uint8_t i = 0; i < KKB_DEBOUNCE_KEYS; i++) {
+        debounce_countdown[i]         = 0;
+        debounce_clean[i]             = 0;
+        debounce_stats[i]             = (kkb_debounce_stats_t){0};
+        debounce_stats[i].debounce_ms = KKB_DEBOUNCE_START;
+    }
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        last_raw[row] = 0;
+    }
+    last_time = timer_read();
+}
+
+// QMK: Debounce (called after every scan)
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    uint16_t now     = timer_read();
+    uint16_t elapsed = TIMER_DIFF_16(now, last_time);
+    last_time        = now;
+
+    // Nothing to do while idle
+    if (!changed && !windows_active) {
+        return false;
+    }
+
+    bool cooked_changed = false;
+    windows_active      = false;
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t transitions = raw[row] ^ last_raw[row];
+        matrix_row_t pending     = raw[row] ^ cooked[row];
+        last_raw[row]            = raw[row];
+
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t      index = row * MATRIX_COLS + col;
+            matrix_row_t mask  = MATRIX_ROW_SHIFTER << col;
+
+            if (debounce_countdown[index] == 0) {
+                // Idle: start a window when the key differs from its debounced state
+                if (pending & mask) {
+                    debounce_countdown[index] = debounce_stats[index].debounce_ms;
+                    debounce_span[index]      = 0;
+                    debounce_bounced[index]   = false;
+                    windows_active            = true;
+                }
+                continue;
+            }
+
+            debounce_span[index] = saturating_add(debounce_span[index], elapsed);
+
+            if (transitions & mask) {
+                // Bounce: count it and restart the window
+                kkb_debounce_stats_t *stats = &debounce_stats[index];
+                if (stats->bounces < UINT16_MAX) {
+                    stats->bounces++;
+                }
+                if (debounce_span[index] > stats->max_bounce) {
+                    stats->max_bounce = debounce_span[index];
+                }
+                debounce_bounced[index]   = true;
+                debounce_countdown[index] = stats->debounce_ms;
+                windows_active            = true;
+            } else if (debounce_countdown[index] <= elapsed) {
+                // Stable for the key's debounce time: commit, if still different
+                debounce_countdown[index] = 0;
+                if (pending & mask) {
+                    cooked[row] ^= mask;
+                    cooked_changed = true;
+                    if (debounce_stats[index].changes < UINT16_MAX) {
+                        debounce_stats[index].changes++;
+                    }
+                }
+                adapt_debounce_time(index);
+            } else {
+                debounce_countdown[index] -= elapsed;
+                windows_active = true;
+            }
+        }
+    }
+
+    return cooked_changed;
+}
+
+// QMK: Debounce free (nothing allocated)
+void debounce_free(void) {}
+
+// Copy the statistics of one key
+void kkb_debounce_get_stats(uint8_t row, uint8_t col, kkb_debounce_stats_t *stats) {
+    *stats = debounce_stats[row * MATRIX_COLS + col];
+}
+
+// Reset statistics, but keep the adapted debounce times
+void kkb_debounce_reset_stats(void) {
+    for (uint8_t i = 0; i < KKB_DEBOUNCE_KEYS; i++) {
+        uint8_t debounce_ms           = debounce_stats[i].debounce_ms;
+        debounce_stats[i]             = (kkb_debounce_stats_t){0};
+        debounce_stats[i].debounce_ms = debounce_ms;
+    }
+}
+
+// Print statistics for all keys that bounced or had a non-default debounce time
+void kkb_debounce_dump_stats(void) {
+    uprintf("DBNC BEGIN %u %u %u\n", KKB_DEBOUNCE_MIN, KKB_DEBOUNCE_START, KKB_DEBOUNCE_MAX);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            const kkb_debounce_stats_t *stats = &debounce_stats[row * MATRIX_COLS + col];
+            if (stats->changes == 0 && stats->bounces == 0) {
+                continue;
+            }
+            // row col changes bounces max_bounce_ms debounce_ms
+            uprintf("DBNC %u %u %u %u %u %u\n", row, col, stats->changes, stats->bounces, stats->max_bounce, stats->debounce_ms);
+        }
+    }
+    uprintf("DBNC END\n");
+}
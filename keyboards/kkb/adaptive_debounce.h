@@ -0,0 +1,56 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief Per-key adaptive debounce (DEBOUNCE_TYPE = custom, see rules.mk)
+ *
+ * Each key is debounced on its own (deferred, as sym_defer_pk), with its own
+ * debounce time. A key that bounces inside its window gets a longer time, a
+ * key that stays clean for a number of presses gets a shorter one, within
+ * KKB_DEBOUNCE_MIN and KKB_DEBOUNCE_MAX. Bounce statistics are kept per key,
+ * so worn (chattering) switches can be found.
+ */
+
+// Lowest per-key debounce time (ms)
+#ifndef KKB_DEBOUNCE_MIN
+#    define KKB_DEBOUNCE_MIN 2
+#endif
+
+// Highest per-key debounce time (ms)
+#ifndef KKB_DEBOUNCE_MAX
+#    define KKB_DEBOUNCE_MAX 20
+#endif
+
+// Start value for all keys (ms)
+#ifndef KKB_DEBOUNCE_START
+#    ifdef DEBOUNCE
+#        define KKB_DEBOUNCE_START DEBOUNCE
+#    else
+#        define KKB_DEBOUNCE_START 5
+#    endif
+#endif
+
+// Clean (bounce free) changes before a key's debounce time is lowered by 1 ms
+#ifndef KKB_DEBOUNCE_CLEAN_STEPS
+#    define KKB_DEBOUNCE_CLEAN_STEPS 64
+#endif
+
+_Static_assert(KKB_DEBOUNCE_MIN >= 1 && KKB_DEBOUNCE_MIN <= KKB_DEBOUNCE_START && KKB_DEBOUNCE_START <= KKB_DEBOUNCE_MAX && KKB_DEBOUNCE_MAX <= 255, "Invalid KKB_DEBOUNCE_* bounds");
+
+/**
+ * @brief Bounce statistics for one key
+ */
+typedef struct {
+    uint16_t changes;     // Debounced state changes
+    uint16_t bounces;     // Raw transitions inside a debounce window
+    uint8_t  max_bounce;  // Longest bounce seen (ms from first change to last transition)
+    uint8_t  debounce_ms; // Current debounce time
+} kkb_debounce_stats_t;
+
+void kkb_debounce_get_stats(uint8_t row, uint8_t col, kkb_debounce_stats_t *stats);
+void kkb_debounce_reset_stats(void);
+void kkb_debounce_dump_stats(void);
@@ -0,0 +1,106 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "boot_profile.h"
+#include "cycle_time.h"
+#include "usb_main.h"
+#include "print.h"
+
+uint16_t kkb_boot_marked = 0; // Bit per recorded milestone
+
+// Taken before RAM is initialised, so kept in the no-init RAM section
+static uint32_t boot_clocks_cycles __attribute__((section(".ram0")));
+
+static uint32_t boot_cycles[KKB_BOOT_MILESTONES];
+static uint32_t boot_post_init_time;
+static bool     boot_deferred_done = false;
+
+static const char *const boot_milestone_names[KKB_BOOT_MILESTONES] = {
+    "reset", "clocks", "matrix_init", "first_scan", "post_init", "usb_configured", "deferred_init", "first_frame",
+};
+
+// QMK (ChibiOS): First code after reset, start the cycle counter
+void early_hardware_init_pre(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+#if EARLY_INIT_PERFORM_BOOTLOADER_JUMP
+    // Keep QMK's default behaviour (jump to the bootloader if requested)
+    void enter_bootloader_mode_if_requested(void);
+    enter_bootloader_mode_if_requested();
+#endif
+}
+
+// QMK (ChibiOS): Clocks are up
+void early_hardware_init_post(void) {
+    boot_clocks_cycles = DWT->CYCCNT;
+}
+
+// Record a milestone (first time only, see kkb_boot_mark)
+void kkb_boot_mark_slow(uint8_t milestone) {
+    uint32_t cycles = DWT->CYCCNT;
+
+    if (kkb_boot_marked == 0) {
+        boot_cycles[KKB_BOOT_RESET]  = 0;
+        boot_cycles[KKB_BOOT_CLOCKS] = boot_clocks_cycles;
+        kkb_boot_marked              = (1U << KKB_BOOT_RESET) | (1U << KKB_BOOT_CLOCKS);
+    }
+
+    boot_cycles[milestone] = cycles;
+    kkb_boot_marked |= (1U << milestone);
+}
+
+// Time of a milestone since reset (us), 0 if not reached
+uint32_t kkb_boot_time_us(uint8_t milestone) {
+    if (!(kkb_boot_marked & (1U << milestone))) {
+        return 0;
+    }
+
+    // Cycles up to the clock setup run at the reset clock
+    uint32_t cycles   = boot_cycles[milestone];
+    uint32_t clocks   = boot_cycles[KKB_BOOT_CLOCKS];
+    uint32_t reset_us = MIN(cycles, clocks) / (KKB_BOOT_RESET_CLOCK / 1000000U);
+
+    if (cycles <= clocks) {
+        return reset_us;
+    }
+    return reset_us + CYCLES_TO_US(cycles - clocks);
+}
+
+// Start the deferred init timeout
+void kkb_boot_post_init(void) {
+    kkb_boot_mark(KKB_BOOT_POST_INIT);
+    boot_post_init_time = timer_read32();
+}
+
+// Housekeeping: USB configured milestone, deferred init
+void kkb_boot_task(void) {
+    if (!(kkb_boot_marked & (1U << KKB_BOOT_USB_CONFIGURED)) && USB_DRIVER.state == USB_ACTIVE) {
+        kkb_boot_mark(KKB_BOOT_USB_CONFIGURED);
+    }
+
+    if (boot_deferred_done) {
+        return;
+    }
+    if (!(kkb_boot_marked & (1U << KKB_BOOT_USB_CONFIGURED)) && timer_elapsed32(boot_post_init_time) < KKB_BOOT_DEFER_TIMEOUT) {
+        return;
+    }
+
+    boot_deferred_done = true;
+    keyboard_deferred_init_kb();
+    kkb_boot_mark(KKB_BOOT_DEFERRED_INIT);
+}
+
+__attribute__((weak)) void keyboard_deferred_init_user(void) {}
+
+// Print all milestones (us since reset)
+void kkb_boot_dump(void) {
+    for (uint8_t milestone = 0; milestone < KKB_BOOT_MILESTONES; milestone++) {
+        if (kkb_boot_marked & (1U << milestone)) {
+            uprintf("BOOT %s %lu\n", boot_milestone_names[milestone], (unsigned long)kkb_boot_time_us(milestone));
+        } else {
+            uprintf("BOOT %s -\n", boot_milestone_names[milestone]);
+        }
+    }
+}
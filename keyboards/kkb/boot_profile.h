@@ -0,0 +1,69 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief Boot milestones and deferred initialisation
+ *
+ * Milestones are timestamped with the DWT cycle counter, which is started
+ * at reset (early_hardware_init_pre). Work that is not needed to scan and
+ * enumerate (RGB setup, eeconfig reads in keymaps) runs in
+ * keyboard_deferred_init_kb(), once USB is configured, or after
+ * KKB_BOOT_DEFER_TIMEOUT when there is no host (charger, KVM switched away).
+ * With KKB_RGB_ASYNC_ENABLE this includes the I2C and LED driver init
+ * (rgb_flush.h), otherwise QMK's rgb_matrix_init() does it in keyboard_init().
+ * RM_* keycodes are ignored until the deferred init is done, it would
+ * overwrite their changes.
+ *
+ * Milestones are dumped with KC_DIAG.
+ */
+
+// Deferred init runs at the latest this long (ms) after post init
+#ifndef KKB_BOOT_DEFER_TIMEOUT
+#    define KKB_BOOT_DEFER_TIMEOUT 1000
+#endif
+
+// Core clock from reset until the clocks are set up (STM32L4: MSI 4 MHz)
+#ifndef KKB_BOOT_RESET_CLOCK
+#    define KKB_BOOT_RESET_CLOCK 4000000U
+#endif
+
+// Boot milestones, in expected order
+enum kkb_boot_milestone {
+    KKB_BOOT_RESET,          // early_hardware_init_pre(), cycle counter start
+    KKB_BOOT_CLOCKS,         // early_hardware_init_post(), clocks up
+    KKB_BOOT_MATRIX_INIT,    // matrix_init_custom()
+    KKB_BOOT_FIRST_SCAN,     // First matrix_scan_custom()
+    KKB_BOOT_POST_INIT,      // keyboard_post_init_kb()
+    KKB_BOOT_USB_CONFIGURED, // USB configured by the host
+    KKB_BOOT_DEFERRED_INIT,  // keyboard_deferred_init_kb() done
+    KKB_BOOT_FIRST_FRAME,    // First rendered LED frame
+    KKB_BOOT_MILESTONES
+};
+
+extern uint16_t kkb_boot_marked;
+
+void     kkb_boot_mark_slow(uint8_t milestone);
+uint32_t kkb_boot_time_us(uint8_t milestone);
+void     kkb_boot_post_init(void);
+void     kkb_boot_task(void);
+void     kkb_boot_dump(void);
+
+// Record a milestone, only the first time it is reached
+static inline void kkb_boot_mark(uint8_t milestone) {
+    if (!(kkb_boot_marked & (1U << milestone))) {
+        kkb_boot_mark_slow(milestone);
+    }
+}
+
+// Deferred init done: RGB set up, keymap eeconfig read
+static inline bool kkb_boot_deferred_done(void) {
+    return kkb_boot_marked & (1U << KKB_BOOT_DEFERRED_INIT);
+}
+
+// Deferred initialisation (after USB enumeration)
+void keyboard_deferred_init_kb(void);
+void keyboard_deferred_init_user(void);
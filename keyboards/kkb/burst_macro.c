@@ -0,0 +1,150 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "burst_macro.h"
+
+#ifdef KKB_BURST_ENABLE
+
+// Characters map through QMK's send_string tables, serial fallback is send_string()
+#    ifndef SEND_STRING_ENABLE
+#        error "KKB_BURST_ENABLE needs SEND_STRING_ENABLE = yes in the keymap rules.mk"
+#    endif
+
+#    include "send_string.h"
+#    include "print.h"
+
+#    ifndef PGM_LOADBIT
+#        define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+#    endif
+
+static uint16_t burst_reports; // Reports sent by the last string
+
+// Pending group: keys pressed together, in increasing order
+static uint8_t group_keys[KKB_BURST_MAX_KEYS];
+static uint8_t group_count = 0;
+static uint8_t group_mods  = 0;
+
+static bool burst_nkro(void) {
+#    ifdef NKRO_ENABLE
+    return host_can_send_nkro();
+#    else
+    return false;
+#    endif
+}
+
+static void burst_report(void) {
+    send_keyboard_report();
+    burst_reports++;
+#    if KKB_BURST_REPORT_DELAY_MS > 0
+    wait_ms(KKB_BURST_REPORT_DELAY_MS);
+#    endif
+}
+
+// Keycode and modifiers of a character (send_string() tables), false when it is typed serially
+static bool burst_char(char ascii, uint8_t *keycode, uint8_t *mods) {
+    uint8_t c = (uint8_t)ascii;
+
+    if (c >= 128 || PGM_LOADBIT(ascii_to_dead_lut, c)) {
+        return false;
+    }
+    *keycode = pgm_read_byte(&ascii_to_keycode_lut[c]);
+    *mods    = (PGM_LOADBIT(ascii_to_shift_lut, c) ? MOD_BIT(KC_LEFT_SHIFT) : 0) | (PGM_LOADBIT(ascii_to_altgr_lut, c) ? MOD_BIT(KC_RIGHT_ALT) : 0);
+
+    return *keycode != KC_NO && !IS_MODIFIER_KEYCODE(*keycode);
+}
+
+// Press and release the pending group, the release report carries the next modifiers
+static void burst_flush(uint8_t next_mods) {
+    if (group_count == 0) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < group_count; i++) {
+        add_key(group_keys[i]);
+    }
+    burst_report();
+
+    for (uint8_t i = 0; i < group_count; i++) {
+        del_key(group_keys[i]);
+    }
+    set_weak_mods(next_mods);
+    burst_report();
+
+    group_count = 0;
+    group_mods  = next_mods;
+}
+
+// Type a string, several characters per report
+void kkb_burst_send_string(const char *str) {
+    burst_reports = 0;
+
+    if (!burst_nkro()) {
+        // 6KRO report: the host may not keep the order of the keys
+        send_string(str);
+        return;
+    }
+
+    group_count = 0;
+    group_mods  = 0;
+
+    for (; *str; str++) {
+        uint8_t keycode, mods;
+
+        if (!burst_char(*str, &keycode, &mods)) {
+            burst_flush(0);
+            send_char(*str);
+            continue;
+        }
+
+        if (group_count > 0 && (mods != group_mods || keycode <= group_keys[group_count - 1] || group_count == KKB_BURST_MAX_KEYS)) {
+            burst_flush(mods);
+        }
+        if (group_count == 0) {
+            set_weak_mods(mods);
+            group_mods = mods;
+        }
+        group_keys[group_count++] = keycode;
+    }
+
+    burst_flush(0);
+}
+
+// Key combination (modifiers and keys) pressed or released in one report
+void kkb_burst_combo(const uint8_t *keycodes, uint8_t len, bool pressed) {
+    for (uint8_t i = 0; i < len; i++) {
+        if (IS_MODIFIER_KEYCODE(keycodes[i])) {
+            if (pressed) {
+                add_mods(MOD_BIT(keycodes[i]));
+            } else {
+                del_mods(MOD_BIT(keycodes[i]));
+            }
+        } else {
+            if (pressed) {
+                add_key(keycodes[i]);
+            } else {
+                del_key(keycodes[i]);
+            }
+        }
+    }
+    send_keyboard_report();
+}
+
+// Type the benchmark text in burst and serial mode, print the times
+void kkb_burst_benchmark(void) {
+    static const char text[] = KKB_BURST_BENCH_TEXT;
+
+    uint32_t start = timer_read32();
+    kkb_burst_send_string(text);
+    uint32_t burst_ms = timer_elapsed32(start);
+    tap_code(KC_ENTER);
+
+    start = timer_read32();
+    send_string(text);
+    uint32_t serial_ms = timer_elapsed32(start);
+    tap_code(KC_ENTER);
+
+    // nkro chars burst_reports burst_ms serial_ms (time to queue the reports)
+    uprintf("BRST %u %u %u %lu %lu\n", burst_nkro(), (unsigned)(sizeof(text) - 1), burst_reports, (unsigned long)burst_ms, (unsigned long)serial_ms);
+}
+
+#endif
@@ -0,0 +1,49 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief Burst macro output (opt-in, define KKB_BURST_ENABLE in config.h)
+ *
+ * send_string() types one character at a time: a press and a release
+ * report per character, plus two for the shift. The burst engine presses
+ * several characters in the same NKRO report, when they need the same
+ * modifiers and their keycodes are in increasing order (the host reads
+ * the keys of a report in usage order, and a repeated key needs a release
+ * in between). Modifier changes go with the release report. Dead keys are
+ * typed with send_char(), and the whole string with send_string() when
+ * the host does not use the NKRO report (boot protocol, NKRO off).
+ *
+ * The KC_TASK-style combos are pressed and released in one report each.
+ *
+ * KC_BRST types KKB_BURST_BENCH_TEXT with the burst engine, then with
+ * send_string(), each followed by Enter, and prints a BRST line. Decode
+ * a capture of the reports with tools/burst_decode.py for the throughput
+ * seen by the host.
+ */
+
+// Keys pressed in one report
+#ifndef KKB_BURST_MAX_KEYS
+#    define KKB_BURST_MAX_KEYS 6
+#endif
+
+// Delay after each report (ms), 0: the USB driver paces the reports
+#ifndef KKB_BURST_REPORT_DELAY_MS
+#    define KKB_BURST_REPORT_DELAY_MS 0
+#endif
+
+// Benchmark text (same keys in the US and Norwegian layouts)
+#ifndef KKB_BURST_BENCH_TEXT
+#    define KKB_BURST_BENCH_TEXT "the quick brown fox jumps over the lazy dog THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789"
+#endif
+
+#ifdef KKB_BURST_ENABLE
+
+void kkb_burst_send_string(const char *str);
+void kkb_burst_combo(const uint8_t *keycodes, uint8_t len, bool pressed);
+void kkb_burst_benchmark(void);
+
+#endif
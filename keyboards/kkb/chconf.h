@@ -0,0 +1,12 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Thread working areas painted at creation, and their bases kept (stack_watch.c)
+#ifdef KKB_STACK_WATCH_ENABLE
+#    define CH_DBG_FILL_THREADS TRUE
+#    define CH_DBG_ENABLE_STACK_CHECK TRUE
+#endif
+
+#include_next <chconf.h>
@@ -20,15 +20,32 @@
 #endif
 
 
+// HC595 column driver (see hc595_matrix.h): column 0 on GPIO, 15 columns on two HC595
+#define HC595_STCP_PIN B0
+#define HC595_SHCP_PIN A1
+#define HC595_DS_PIN A7
+#define HC595_COUNT 2
+#define HC595_GPIO_COLS 1
+
 // BT Pin definition
 #define USB_BT_MODE_SELECT_PIN A10
 
 // I2C Configuration
-#define I2C1_TIMINGR_PRESC 0U
-#define I2C1_TIMINGR_SCLDEL 3U
-#define I2C1_TIMINGR_SDADEL 0U
-#define I2C1_TIMINGR_SCLH 15U
-#define I2C1_TIMINGR_SCLL 51U
+// Define KKB_I2C_FAST_MODE_PLUS for 1 MHz (RM0394 timing for a 48 MHz I2C clock, FM+ pin drive in rgb_flush.c)
+// #define KKB_I2C_FAST_MODE_PLUS
+#ifdef KKB_I2C_FAST_MODE_PLUS
+#    define I2C1_TIMINGR_PRESC 5U
+#    define I2C1_TIMINGR_SCLDEL 1U
+#    define I2C1_TIMINGR_SDADEL 0U
+#    define I2C1_TIMINGR_SCLH 1U
+#    define I2C1_TIMINGR_SCLL 3U
+#else
+#    define I2C1_TIMINGR_PRESC 0U
+#    define I2C1_TIMINGR_SCLDEL 3U
+#    define I2C1_TIMINGR_SDADEL 0U
+#    define I2C1_TIMINGR_SCLH 15U
+#    define I2C1_TIMINGR_SCLL 51U
+#endif
 
 // Factory test support
 #define FN_KEY1 MO(2)
@@ -0,0 +1,25 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief Timing with the DWT cycle counter
+ *
+ * The counter runs from reset (early_hardware_init_pre() in boot_profile.c),
+ * at the core clock once the clocks are set up. It wraps after about 53 s at
+ * 80 MHz, so only differences of up to that are timed.
+ */
+
+// Cycles of the core clock to microseconds
+#define CYCLES_TO_US(cycles) ((cycles) / (STM32_SYSCLK / 1000000U))
+
+// Time since start_cycles (us) into last, and into max when longer
+static inline void kkb_update_time(uint32_t *last, uint32_t *max, uint32_t start_cycles) {
+    *last = CYCLES_TO_US(DWT->CYCCNT - start_cycles);
+    if (*last > *max) {
+        *max = *last;
+    }
+}
@@ -8,4 +8,7 @@
 // Enable I2C for RGB matrix driver
 #define HAL_USE_I2C TRUE
 
+// Row EXTI callbacks, wake from USB suspend (matrix.c)
+#define PAL_USE_CALLBACKS TRUE
+
 #include_next <halconf.h>
@@ -0,0 +1,148 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief HC595 column driver for ROW2COL matrices (used by matrix.c)
+ *
+ * Columns are either GPIO (the first HC595_GPIO_COLS columns, pins from
+ * MATRIX_COL_PINS) or outputs of a chain of HC595_COUNT shift registers (all
+ * following columns, NO_PIN in MATRIX_COL_PINS). Everything is configured in
+ * config.h and resolved at compile time, so the write loop has a fixed
+ * length and the select data for a column is a constant shift.
+ *
+ * Defaults match the K7 Pro: 1 GPIO column and two HC595 (15 columns) on
+ * B0/A1/A7, shifted MSB first, active low.
+ */
+
+// Control pins
+#ifndef HC595_STCP_PIN
+#    define HC595_STCP_PIN B0 // Storage (latch) clock
+#endif
+#ifndef HC595_SHCP_PIN
+#    define HC595_SHCP_PIN A1 // Shift clock
+#endif
+#ifndef HC595_DS_PIN
+#    define HC595_DS_PIN A7 // Serial data
+#endif
+
+// Number of chained HC595 (1, 2 or 4)
+#ifndef HC595_COUNT
+#    define HC595_COUNT 2
+#endif
+
+// Leading GPIO columns, the rest are HC595 outputs
+#ifndef HC595_GPIO_COLS
+#    define HC595_GPIO_COLS 1
+#endif
+
+// HC595 output of the first shift-register column (outputs below it are unused)
+#ifndef HC595_BIT_OFFSET
+#    define HC595_BIT_OFFSET 0
+#endif
+
+// Delay (nop loops) around clock edges
+#ifndef HC595_DELAY
+#    define HC595_DELAY 1
+#endif
+
+// Optional: define HC595_LSB_FIRST to shift the lowest output first
+// Optional: define HC595_ACTIVE_HIGH for columns selected by a high output
+
+#if HC595_COUNT == 1
+typedef uint8_t hc595_data_t;
+#elif HC595_COUNT == 2
+typedef uint16_t hc595_data_t;
+#elif HC595_COUNT == 4
+typedef uint32_t hc595_data_t;
+#else
+#    error "HC595_COUNT must be 1, 2 or 4"
+#endif
+
+#define HC595_BITS (HC595_COUNT * 8)
+#define HC595_MSB ((hc595_data_t)1 << (HC595_BITS - 1))
+
+_Static_assert(HC595_GPIO_COLS <= MATRIX_COLS, "HC595_GPIO_COLS larger than MATRIX_COLS");
+_Static_assert(HC595_BIT_OFFSET + MATRIX_COLS - HC595_GPIO_COLS <= HC595_BITS, "Not enough HC595 outputs for the shift-register columns");
+
+// Output data with no column selected, and with all columns selected
+#ifdef HC595_ACTIVE_HIGH
+#    define HC595_NONE ((hc595_data_t)0)
+#    define HC595_ALL ((hc595_data_t)~(hc595_data_t)0)
+#else
+#    define HC595_NONE ((hc595_data_t)~(hc595_data_t)0)
+#    define HC595_ALL ((hc595_data_t)0)
+#endif
+
+// True for columns driven by a GPIO pin
+#define HC595_IS_GPIO_COL(col) ((col) < HC595_GPIO_COLS)
+
+// Output data selecting one shift-register column
+static inline hc595_data_t hc595_col_data(uint8_t col) {
+    hc595_data_t bit = (hc595_data_t)1 << (col - HC595_GPIO_COLS + HC595_BIT_OFFSET);
+#ifdef HC595_ACTIVE_HIGH
+    return bit;
+#else
+    return (hc595_data_t)~bit;
+#endif
+}
+
+static inline void hc595_delay(uint16_t n) {
+    while (n-- > 0) {
+        asm volatile("nop" ::: "memory");
+    }
+}
+
+// Disable 'int-to-pointer-cast' (pin macros on ChibiOS)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
+
+// Configure the control pins
+static inline void hc595_init(void) {
+    setPinOutput(HC595_DS_PIN);
+    setPinOutput(HC595_STCP_PIN);
+    setPinOutput(HC595_SHCP_PIN);
+}
+
+// Shift out and latch the outputs of the whole chain
+static inline void hc595_write(hc595_data_t data) {
+    for (uint8_t i = HC595_BITS; i > 0; i--) {
+        writePinLow(HC595_SHCP_PIN);
+
+#ifdef HC595_LSB_FIRST
+        if (data & 1) {
+#else
+        if (data & HC595_MSB) {
+#endif
+            writePinHigh(HC595_DS_PIN);
+        } else {
+            writePinLow(HC595_DS_PIN);
+        }
+
+#ifdef HC595_LSB_FIRST
+        data >>= 1;
+#else
+        data <<= 1;
+#endif
+        hc595_delay(HC595_DELAY);
+        writePinHigh(HC595_SHCP_PIN);
+        hc595_delay(HC595_DELAY);
+    }
+
+    hc595_delay(HC595_DELAY);
+    writePinLow(HC595_STCP_PIN);
+    hc595_delay(HC595_DELAY);
+    writePinHigh(HC595_STCP_PIN);
+}
+
+// Park the control pins low, the latches hold the outputs
+static inline void hc595_park(void) {
+    writePinLow(HC595_DS_PIN);
+    writePinLow(HC595_SHCP_PIN);
+    writePinLow(HC595_STCP_PIN);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,79 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "key_recorder.h"
+
+#ifdef KKB_KEY_RECORDER_ENABLE
+
+#    ifndef CONSOLE_ENABLE
+#        error "KKB_KEY_RECORDER_ENABLE requires CONSOLE_ENABLE = yes in rules.mk"
+#    endif
+
+#    include "print.h"
+
+// One raw row change
+typedef struct PACKED {
+    uint32_t     cycles; // DWT cycle counter at scan
+    uint16_t     ms;     // timer_read() at scan, resolves cycle counter wraps
+    uint8_t      row;
+    matrix_row_t state; // New raw state of the row
+} key_record_t;
+
+static key_record_t key_records[KKB_KEY_RECORDER_SIZE];
+static uint16_t     key_records_head    = 0; // Next slot to write
+static uint16_t     key_records_count   = 0;
+static uint32_t     key_records_dropped = 0; // Overwritten (oldest) records
+static matrix_row_t key_records_last[MATRIX_ROWS];
+
+// Records are timed with the cycle counter, running since reset (see boot_profile.c)
+void key_recorder_init(void) {
+    key_recorder_clear();
+}
+
+// Log rows that changed since the last call (call after a changed scan)
+void key_recorder_scan(const matrix_row_t *raw) {
+    uint32_t cycles = DWT->CYCCNT;
+    uint16_t ms     = timer_read();
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (raw[row] == key_records_last[row]) {
+            continue;
+        }
+        key_records_last[row] = raw[row];
+
+        key_record_t *record = &key_records[key_records_head];
+        record->cycles       = cycles;
+        record->ms           = ms;
+        record->row          = row;
+        record->state        = raw[row];
+
+        key_records_head = (key_records_head + 1) % KKB_KEY_RECORDER_SIZE;
+        if (key_records_count < KKB_KEY_RECORDER_SIZE) {
+            key_records_count++;
+        } else {
+            key_records_dropped++;
+        }
+    }
+}
+
+// Reset the buffer, but keep the last known state (next change is a delta)
+void key_recorder_clear(void) {
+    key_records_head    = 0;
+    key_records_count   = 0;
+    key_records_dropped = 0;
+}
+
+// Print all records, oldest first (format parsed by tools/keyrec_replay.py)
+void key_recorder_dump(void) {
+    uint16_t index = (key_records_head + KKB_KEY_RECORDER_SIZE - key_records_count) % KKB_KEY_RECORDER_SIZE;
+
+    uprintf("KREC BEGIN %u %lu %lu\n", key_records_count, (unsigned long)STM32_SYSCLK, (unsigned long)key_records_dropped);
+    for (uint16_t i = 0; i < key_records_count; i++) {
+        const key_record_t *record = &key_records[index];
+        uprintf("KREC %08lX %04X %u %04X\n", (unsigned long)record->cycles, record->ms, record->row, record->state);
+        index = (index + 1) % KKB_KEY_RECORDER_SIZE;
+    }
+    uprintf("KREC END\n");
+}
+
+#endif
@@ -0,0 +1,28 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief Key event recorder (opt-in, define KKB_KEY_RECORDER_ENABLE in config.h)
+ *
+ * Logs raw matrix row changes from matrix_scan_custom() with a cycle counter
+ * timestamp into a RAM ring buffer. The buffer is dumped over the console,
+ * and can be replayed on the host with tools/keyrec_replay.py
+ */
+
+// Number of row changes kept in the ring buffer (9 bytes each)
+#ifndef KKB_KEY_RECORDER_SIZE
+#    define KKB_KEY_RECORDER_SIZE 256
+#endif
+
+#ifdef KKB_KEY_RECORDER_ENABLE
+
+void key_recorder_init(void);
+void key_recorder_scan(const matrix_row_t *raw);
+void key_recorder_dump(void);
+void key_recorder_clear(void);
+
+#endif
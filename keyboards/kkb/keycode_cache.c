@@ -0,0 +1,141 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode_cache.h"
+
+#ifdef KKB_KEYCODE_CACHE_ENABLE
+
+#    include "cycle_time.h"
+#    include "print.h"
+
+static uint16_t      cache_keycodes[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t       cache_layers[MATRIX_ROWS][MATRIX_COLS]; // Layer of the keycode
+static uint8_t       cache_highest;
+static layer_state_t cache_state;
+static bool          cache_valid = false;
+
+static uint32_t cache_rebuilds      = 0;
+static uint32_t cache_rebuild_max   = 0; // Cycles
+static uint32_t cache_rebuild_total = 0; // Cycles
+
+// Resolve a position as QMK's layer_switch_get_layer(): layer 0 when all active layers are KC_TRNS
+static uint8_t resolve(layer_state_t state, uint8_t row, uint8_t col, uint16_t *keycode) {
+    for (int8_t layer = get_highest_layer(state); layer >= 0; layer--) {
+        if (state & ((layer_state_t)1 << layer)) {
+            *keycode = keycode_at_keymap_location(layer, row, col);
+            if (*keycode != KC_TRNS) {
+                return layer;
+            }
+        }
+    }
+    *keycode = keycode_at_keymap_location(0, row, col);
+    return 0;
+}
+
+static void cache_rebuild(layer_state_t state) {
+    uint32_t start = DWT->CYCCNT;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            cache_layers[row][col] = resolve(state, row, col, &cache_keycodes[row][col]);
+        }
+    }
+    cache_highest = get_highest_layer(state);
+    cache_state   = state;
+    cache_valid   = true;
+
+    uint32_t cycles = DWT->CYCCNT - start;
+    cache_rebuilds++;
+    cache_rebuild_total += cycles;
+    if (cycles > cache_rebuild_max) {
+        cache_rebuild_max = cycles;
+    }
+}
+
+static inline void cache_check(void) {
+    layer_state_t state = layer_state | default_layer_state;
+    if (!cache_valid || state != cache_state) {
+        cache_rebuild(state);
+    }
+}
+
+uint16_t kkb_keycode_cache_get(uint8_t row, uint8_t col) {
+    cache_check();
+    return cache_keycodes[row][col];
+}
+
+uint8_t kkb_keycode_cache_highest(void) {
+    cache_check();
+    return cache_highest;
+}
+
+// QMK: Keycode of a key on a layer. Called for each active layer by the layer walk on press
+// (layer_switch_get_layer()), and for the layer of the press on release (source layer cache)
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return KC_NO;
+    }
+
+    cache_check();
+    uint8_t source = cache_layers[key.row][key.col];
+    if (layer == source) {
+        return cache_keycodes[key.row][key.col];
+    }
+    if (layer > source && (cache_state & ((layer_state_t)1 << layer))) {
+        // Active layers above the source layer are transparent here
+        return KC_TRNS;
+    }
+    // Any other layer, e.g. the layer of a press on release after a layer change
+    return keycode_at_keymap_location(layer, key.row, key.col);
+}
+
+// Print the rebuilds, and the cost of a whole matrix lookup: through the layers, QMK's layer walk with the cache
+// (key event), and from the cache (LED frame)
+void kkb_keycode_cache_dump(void) {
+    cache_check();
+    layer_state_t     state      = cache_state;
+    uint16_t          mismatches = 0;
+    uint16_t          keycode;
+    volatile uint16_t sink;
+
+    uint32_t start = DWT->CYCCNT;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            resolve(state, row, col, &keycode);
+            sink = keycode;
+        }
+    }
+    uint32_t uncached = DWT->CYCCNT - start;
+
+    start = DWT->CYCCNT;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keypos_t key = {.row = row, .col = col};
+            sink         = keymap_key_to_keycode(layer_switch_get_layer(key), key);
+        }
+    }
+    uint32_t event = DWT->CYCCNT - start;
+
+    start = DWT->CYCCNT;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            sink = kkb_keycode_cache_get(row, col);
+        }
+    }
+    uint32_t frame = DWT->CYCCNT - start;
+    (void)sink;
+
+    // Both cached paths against the walk through the keymap layers
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keypos_t key = {.row = row, .col = col};
+            resolve(state, row, col, &keycode);
+            mismatches += keycode != keymap_key_to_keycode(layer_switch_get_layer(key), key) || keycode != kkb_keycode_cache_get(row, col);
+        }
+    }
+
+    // rebuilds rebuild_us_avg rebuild_us_max, cycles for 80 keys: uncached event_cached frame_cached, mismatches
+    uprintf("KCCH %lu %lu %lu %lu %lu %lu %u\n", (unsigned long)cache_rebuilds, (unsigned long)CYCLES_TO_US(cache_rebuild_total / (cache_rebuilds ? cache_rebuilds : 1)), (unsigned long)CYCLES_TO_US(cache_rebuild_max), (unsigned long)uncached, (unsigned long)event, (unsigned long)frame, mismatches);
+}
+
+#endif
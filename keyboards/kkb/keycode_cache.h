@@ -0,0 +1,57 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief Resolved keycode cache (opt-in, define KKB_KEYCODE_CACHE_ENABLE in config.h)
+ *
+ * The effective keycode of every matrix position (the first keycode that is
+ * not KC_TRNS, from the highest active layer down), and the layer it comes
+ * from, for the current layer_state | default_layer_state. Every read checks
+ * the state the cache was built for, and rebuilds it when it changed (layer
+ * keys, and the DIP switch through default_layer_set()). The keymap must
+ * not change at runtime (no dynamic keymap).
+ *
+ * Key events: keymap_key_to_keycode() is answered from the cache, so QMK's
+ * layer walk on press (layer_switch_get_layer()) gets KC_TRNS for the
+ * active layers above the source layer, and the keycode at the source
+ * layer, without reading the keymap. Other layers are read from the keymap:
+ * a release is resolved on the layer of its press (QMK's source layer
+ * cache), whatever the layers are now.
+ *
+ * LED rendering, which looks up every key each frame, reads
+ * kkb_keycode_cache_get(). Without the option the keycode is resolved as
+ * QMK does.
+ *
+ * Rebuild counts and times, the cost of a whole matrix lookup uncached, by
+ * a key event and by a frame, and the positions where the cache differs
+ * from the keymap are dumped with KC_DIAG.
+ */
+
+#ifdef KKB_KEYCODE_CACHE_ENABLE
+
+#    if defined(DYNAMIC_KEYMAP_ENABLE) || defined(ENCODER_MAP_ENABLE) || defined(DIP_SWITCH_MAP_ENABLE)
+#        error "KKB_KEYCODE_CACHE_ENABLE: keymap changed at runtime, or keys outside the matrix"
+#    endif
+
+uint16_t kkb_keycode_cache_get(uint8_t row, uint8_t col);
+uint8_t  kkb_keycode_cache_highest(void);
+void     kkb_keycode_cache_dump(void);
+
+#else
+
+// Effective keycode at a matrix position, for the active layers
+static inline uint16_t kkb_keycode_cache_get(uint8_t row, uint8_t col) {
+    keypos_t key = {.row = row, .col = col};
+    return keymap_key_to_keycode(layer_switch_get_layer(key), key);
+}
+
+// Highest active layer
+static inline uint8_t kkb_keycode_cache_highest(void) {
+    return get_highest_layer(layer_state | default_layer_state);
+}
+
+#endif
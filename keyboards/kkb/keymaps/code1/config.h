@@ -60,6 +60,34 @@
 // Keep the solid-color
 #define RGB_MATRIX_STARTUP_MODE RGB_MATRIX_SOLID_COLOR
 
+// Reactive keys on the base layers: pressed keys flash and fade (keyboard reactive_heat.h).
+// Uses a 69 byte heat buffer instead of RGB_MATRIX_KEYPRESSES / RGB_MATRIX_FRAMEBUFFER_EFFECTS
+// #define KKB_REACTIVE_ENABLE
+
+// ============================== TAP-HOLD ====================================
+// Caps and NUBS tap as themselves and hold for _C_FN3 / _C_FN4 (keyboard tap_hold.h).
+// Decided from typing speed and the next key, without waiting for the tapping term.
+// Caps is never tapped from typing speed alone: right after typing it waits for the next key or its release
+#define KKB_TAP_HOLD_ENABLE
+
+// ============================== RGB FLUSH ===================================
+// LED frames are sent over I2C by a thread (keyboard rgb_flush.h), scanning never waits on the bus
+#define KKB_RGB_ASYNC_ENABLE
+
+// Frames over KKB_LED_BUDGET_MA (default 400 mA) are dimmed as a whole before they are sent
+// (keyboard led_budget.h), the current estimate uses the M_TV current tune above
+#define KKB_LED_BUDGET_ENABLE
+
+// ============================== STALL WATCH =================================
+// Main loop gaps over KKB_STALL_BUDGET_US are logged with the subsystem that held it
+// (keyboard stall_watch.h), the log survives soft resets and is dumped with KC_DIAG
+#define KKB_STALL_WATCH_ENABLE
+
+// ============================== SPARSE KEYMAP ===============================
+// Keymap lookup from keymap_sparse.h (packed keycodes without KC_NO / KC_TRNS)
+// instead of the dense keymaps[] array, saves flash. Regenerate with tools/keymap_compiler.py
+#define KKB_SPARSE_KEYMAP_ENABLE
+
 // ========================== RGB DELTAS AND LIMITS ===========================
 // Define (0-100%) the default fallback startup brightness
 #define KKB_BRIGHTNESS_STARTUP_FALLBACK_PERCENT 80
@@ -95,3 +123,18 @@
 
 // BRIGHTNESS FALLBACK DEFAULT START VALUE
 #define KKB_BRIGHT_START (((KKB_BRIGHT_START_RAW + 4) / 5) * 5)
+
+// ============================== STACK WATCH =================================
+// Stack high-water marks dumped with KC_DIAG (keyboard stack_watch.h), for RAM sizing.
+// Enables ChibiOS thread stack filling and checking
+// #define KKB_STACK_WATCH_ENABLE
+
+// ============================== BURST OUTPUT ================================
+// KC_TASK-style combos in one report, strings typed several characters per NKRO report
+// (keyboard burst_macro.h). KC_BRST types a benchmark text
+#define KKB_BURST_ENABLE
+
+// ============================ KEYCODE CACHE =================================
+// Effective keycodes of the active layers, for key events and LED rendering
+// (keyboard keycode_cache.h)
+#define KKB_KEYCODE_CACHE_ENABLE
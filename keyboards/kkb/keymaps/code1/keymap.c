@@ -4,6 +4,11 @@
 #include QMK_KEYBOARD_H
 
 #include "keymap_aliases.h"
+#include "keymap_tables.h"
+#include "reactive_heat.h"
+#include "boot_profile.h"
+#include "stall_watch.h"
+#include "keycode_cache.h"
 
 // LAYER COLORS (HSV values)
 static const hsv_t PROGMEM kkb_color_caps         = {HSV_ORANGE};
@@ -53,8 +58,8 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
     [__CODE] = LAYOUT_69_iso(
         KC_ESC,     KC_1,        KC_2,        KC_3,        KC_4,        KC_5,        KC_6,        KC_7,        KC_8,        KC_9,        KC_0,        KC_MINS,     KC_EQL,      KC_BSPC,                     KC_DEL,
         KC_TAB,     KC_Q,        KC_W,        KC_E,        KC_R,        KC_T,        KC_Y,        KC_U,        KC_I,        KC_O,        KC_P,        KC_LBRC,     KC_RBRC,                                  KC_NO,
-        MO(_C_FN3), KC_A,        KC_S,        KC_D,        KC_F,        KC_G,        KC_H,        KC_J,        KC_K,        KC_L,        KC_SCLN,     KC_QUOT,     KC_NUHS,     KC_ENT,                      KC_NO,
-        KC_LSFT,    MO(_C_FN4),  KC_Z,        KC_X,        KC_C,        KC_V,        KC_B,        KC_N,        KC_M,        KC_COMM,     KC_DOT,      KC_SLSH,                  KC_RSFT,     KC_UP,          KC_RCTL,
+        LT(_C_FN3, KC_CAPS), KC_A,        KC_S,        KC_D,        KC_F,        KC_G,        KC_H,        KC_J,        KC_K,        KC_L,        KC_SCLN,     KC_QUOT,     KC_NUHS,     KC_ENT,                      KC_NO,
+        KC_LSFT,    LT(_C_FN4, KC_NUBS), KC_Z,        KC_X,        KC_C,        KC_V,        KC_B,        KC_N,        KC_M,        KC_COMM,     KC_DOT,      KC_SLSH,                  KC_RSFT,     KC_UP,          KC_RCTL,
         KC_LCTL,    KC_LGUI,     KC_LALT,                                            KC_SPC,                                             KC_RALT,     MO(_C_FN1),  MO(_C_FN2),  KC_LEFT,     KC_DOWN,        KC_RGHT),
 
     /**
@@ -140,6 +145,44 @@ const uint16_t PROGMEM keymaps[][MATRIX_ROWS][MATRIX_COLS] = {
 
 // clang-format on
 
+// Generated tables must match the keymap (regenerate with tools/keymap_compiler.py)
+_Static_assert(KKB_TABLE_LAYER_COUNT == _C_CF2 + 1, "keymap_tables.h is out of date");
+_Static_assert(KKB_TABLE_LED_COUNT == RGB_MATRIX_LED_COUNT, "keymap_tables.h LED count mismatch");
+
+#ifdef KKB_SPARSE_KEYMAP_ENABLE
+#    include "keymap_sparse.h"
+
+_Static_assert(KKB_SPARSE_LAYER_COUNT == _C_CF2 + 1, "keymap_sparse.h is out of date");
+_Static_assert(KKB_SPARSE_ROWS == MATRIX_ROWS && KKB_SPARSE_COLS == MATRIX_COLS, "keymap_sparse.h matrix size mismatch");
+
+#    define KKB_XSTR(x) KKB_STR(x)
+#    define KKB_STR(x) #x
+#    pragma message("Sparse keymap: " KKB_XSTR(KKB_SPARSE_BYTES) " bytes instead of " KKB_XSTR(KKB_SPARSE_DENSE_BYTES))
+
+/**
+ * @brief Keymap lookup from the sparse tables, for the overrides in keymap_sparse.c
+ *
+ * A keycode is at the base index of its bitmap word, plus the number of
+ * keycodes before it in that word.
+ */
+uint16_t kkb_sparse_keycode_at(uint8_t layer_num, uint8_t row, uint8_t column) {
+    if (layer_num >= KKB_SPARSE_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) {
+        return KC_TRNS;
+    }
+
+    uint8_t  position = row * MATRIX_COLS + column;
+    uint8_t  word     = position >> 5;
+    uint32_t bit      = 1UL << (position & 31);
+    uint32_t present  = pgm_read_dword(&kkb_sparse_present[layer_num][word]);
+
+    if (present & bit) {
+        uint16_t index = pgm_read_word(&kkb_sparse_base[layer_num][word]) + __builtin_popcount(present & (bit - 1));
+        return pgm_read_word(&kkb_sparse_keycodes[index]);
+    }
+    return (pgm_read_dword(&kkb_sparse_trns[layer_num][word]) & bit) ? KC_TRNS : KC_NO;
+}
+#endif
+
 /**
  * Current main brightness level
  */
@@ -178,6 +221,9 @@ static inline uint8_t kkb_get_brightness(int8_t brightness_offset) {
 /**
  * @brief Set colors based on active keys in current layer, and parameters
  *
+ * Key classification (active, transparent, no-op) is precomputed per layer and
+ * LED at build time, see keymap_tables.h
+ *
  * @param led_min Minimum LED index to process
  * @param led_max Maximum LED index to process
  * @param layer Current layer to analyze
@@ -193,29 +239,20 @@ static void kkb_set_layer_key_colors(uint8_t led_min, uint8_t led_max, uint8_t l
     rgb_t color_controls = kkb_create_color_progmem(&kkb_color_fn_controls, bright_active);
     rgb_t color_inactive = inactive_Off ? kkb_color_off : kkb_create_color_progmem(&kkb_color_win_fn, bright_inactive);
 
-    // Process each key position
-    for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
-        for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
-            uint8_t index = g_led_config.matrix_co[row][col];
-
-            if (index >= led_min && index < led_max && index != NO_LED) {
-                uint16_t keycode = keymap_key_to_keycode(layer, (keypos_t){col, row});
-
-                if (keycode > KC_TRNS) {
-                    // Active key in this layer - highlight it
-                    rgb_matrix_set_color(index, color_active.r, color_active.g, color_active.b);
-                } else if (keycode == KC_TRNS) {
-                    // Transparent key in this layer - highlight it
-                    rgb_matrix_set_color(index, color_controls.r, color_controls.g, color_controls.b);
-                } else if (keycode == KC_NO) {
-                    // Inactive key - dim it or turn off (depending on 'off' param), select color based on CAPS
-                    if (!host_keyboard_led_state().caps_lock) {
-                        rgb_matrix_set_color(index, color_inactive.r, color_inactive.g, color_inactive.b);
-                    } else {
-                        rgb_matrix_set_color(index, color_caps_dim.r, color_caps_dim.g, color_caps_dim.b);
-                    }
-                }
-            }
+    // Inactive key color depends on CAPS, only once per frame
+    rgb_t color_noop = host_keyboard_led_state().caps_lock ? color_caps_dim : color_inactive;
+
+    // Process each LED
+    for (uint8_t index = led_min; index < led_max; ++index) {
+        if (KKB_TABLE_TEST(kkb_layer_active_mask, layer, index)) {
+            // Active key in this layer - highlight it
+            rgb_matrix_set_color(index, color_active.r, color_active.g, color_active.b);
+        } else if (KKB_TABLE_TEST(kkb_layer_trns_mask, layer, index)) {
+            // Transparent key in this layer - highlight it
+            rgb_matrix_set_color(index, color_controls.r, color_controls.g, color_controls.b);
+        } else {
+            // Inactive key - dim it or turn off (depending on 'off' param), select color based on CAPS
+            rgb_matrix_set_color(index, color_noop.r, color_noop.g, color_noop.b);
         }
     }
 }
@@ -235,7 +272,9 @@ static bool kkb_update_brightness(int8_t adjustment) {
     if (new_brightness != g_kkb_brightness) {
         g_kkb_brightness = (uint8_t)new_brightness;
         uint32_t to_save = g_kkb_brightness;
+        kkb_stall_enter(KKB_STALL_EECONFIG);
         eeconfig_update_user(to_save);
+        kkb_stall_leave();
         return true;
     }
     return false;
@@ -296,12 +335,24 @@ static inline void kkb_set_all_leds(uint8_t led_min, uint8_t led_max, rgb_t colo
     bool  caps_active = host_keyboard_led_state().caps_lock;
     rgb_t caps_color  = caps_active ? kkb_create_color_progmem(&kkb_color_caps, kkb_get_brightness(KKB_BRIGHT_DIFF_CAPS)) : color;
 
+#ifdef KKB_REACTIVE_ENABLE
+    // Pressed keys flash in the active color, and fade back (see reactive_heat.h)
+    rgb_t heat_color = kkb_create_color_progmem(&kkb_color_fn_active, kkb_get_brightness(KKB_BRIGHT_DIFF_FN_ACTIVE));
+#endif
+
     for (uint8_t i = led_min; i < led_max; i++) {
-        if (caps_active && (g_led_config.flags[i] & LED_FLAG_KEYLIGHT)) {
-            rgb_matrix_set_color(i, caps_color.r, caps_color.g, caps_color.b);
-        } else {
-            rgb_matrix_set_color(i, color.r, color.g, color.b);
+        rgb_t led_color = (caps_active && (g_led_config.flags[i] & LED_FLAG_KEYLIGHT)) ? caps_color : color;
+
+#ifdef KKB_REACTIVE_ENABLE
+        uint8_t heat = kkb_reactive_heat(i);
+        if (heat) {
+            led_color.r = kkb_reactive_blend(led_color.r, heat_color.r, heat);
+            led_color.g = kkb_reactive_blend(led_color.g, heat_color.g, heat);
+            led_color.b = kkb_reactive_blend(led_color.b, heat_color.b, heat);
         }
+#endif
+
+        rgb_matrix_set_color(i, led_color.r, led_color.g, led_color.b);
     }
 }
 
@@ -324,7 +375,7 @@ static void handle_base_layer(uint8_t led_min, uint8_t led_max, const hsv_t *bas
  *
  * @param led_min Minimum LED index
  * @param led_max Maximum LED index
- * @param layer the layer (to get keycodes from)
+ * @param layer the layer (highest active, keycodes from the resolved keycode cache)
  */
 static void handle_system_config_layer(uint8_t led_min, uint8_t led_max, uint8_t layer) {
     // Set normal layer colors first
@@ -338,7 +389,7 @@ static void handle_system_config_layer(uint8_t led_min, uint8_t led_max, uint8_t
         for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
             uint8_t index = g_led_config.matrix_co[row][col];
             if (index >= led_min && index < led_max && index != NO_LED) {
-                uint16_t keycode = keymap_key_to_keycode(layer, (keypos_t){col, row});
+                uint16_t keycode = kkb_keycode_cache_get(row, col); // Highest layer, without KC_TRNS
 
                 // Check if this is the spacebar (MO(_C_CF2))
                 if (keycode == MO(_C_CF2)) {
@@ -369,18 +420,10 @@ static void handle_bootloader_layer(uint8_t led_min, uint8_t led_max, uint8_t la
     rgb_t sys_max = kkb_create_color_progmem(&kkb_color_sys, KKB_BRIGHT_MAX);
 
     // Highlight only active keys in at maximum brightness
-    for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
-        for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
-            uint8_t index = g_led_config.matrix_co[row][col];
-
-            if (index >= led_min && index < led_max && index != NO_LED) {
-                uint16_t keycode = keymap_key_to_keycode(layer, (keypos_t){col, row});
-
-                if (keycode > KC_TRNS) {
-                    // Active key - use system color at max brightness
-                    rgb_matrix_set_color(index, sys_max.r, sys_max.g, sys_max.b);
-                }
-            }
+    for (uint8_t index = led_min; index < led_max; ++index) {
+        if (KKB_TABLE_TEST(kkb_layer_active_mask, layer, index)) {
+            // Active key - use system color at max brightness
+            rgb_matrix_set_color(index, sys_max.r, sys_max.g, sys_max.b);
         }
     }
 }
@@ -402,7 +445,11 @@ static void handle_bootloader_layer(uint8_t led_min, uint8_t led_max, uint8_t la
  * @return false to indicate we handled all LED processing
  */
 bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
-    uint8_t current_layer = get_highest_layer(layer_state | default_layer_state);
+    uint8_t current_layer = kkb_keycode_cache_highest();
+
+#ifdef KKB_REACTIVE_ENABLE
+    kkb_reactive_decay();
+#endif
 
     switch (current_layer) {
         case __CODE:
@@ -439,9 +486,9 @@ bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
 }
 
 /**
- * @brief Post-init functions
+ * @brief Deferred init, runs after USB enumeration (keyboard boot_profile.h)
  */
-void keyboard_post_init_user(void) {
+void keyboard_deferred_init_user(void) {
     // read last value
     uint32_t raw    = eeconfig_read_user(); // 4 bytes
     uint8_t  stored = (uint8_t)(raw & 0xFF);
@@ -465,7 +512,7 @@ static struct {
  * @return true to continue QMK processing, false to stop
  */
 bool process_record_user(uint16_t keycode, keyrecord_t *record) {
-    if (get_highest_layer(layer_state | default_layer_state) >= __CODE) {
+    if (kkb_keycode_cache_highest() >= __CODE) {
         switch (keycode) {
             case RM_VALU:
                 if (record->event.pressed && !brightness_state.valu_held) {
@@ -5,8 +5,11 @@
 
 // ============================= SELECT LANGUAGE ==============================
 
+// Can also be selected from the command line (e.g. -DHOST_LAYOUT_US=1)
+#if !defined(HOST_LAYOUT_US) && !defined(HOST_LAYOUT_NORWEGIAN)
 // #define HOST_LAYOUT_US       1
 #define HOST_LAYOUT_NORWEGIAN 1
+#endif
 
 // ============================== GENERAL COMBOS ==============================
 // Shortened key-combos used in some layers (for VSCode or other usage)
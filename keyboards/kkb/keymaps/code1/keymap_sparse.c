@@ -0,0 +1,28 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include QMK_KEYBOARD_H
+
+#ifdef KKB_SPARSE_KEYMAP_ENABLE
+#    include "keymap_tables.h"
+
+// Sparse lookup, in keymap.c (the packed keycodes use its layers and aliases)
+uint16_t kkb_sparse_keycode_at(uint8_t layer_num, uint8_t row, uint8_t column);
+
+/**
+ * @brief Keymap lookup from the sparse tables (QMK keymap introspection)
+ *
+ * QMK compiles keymap.c inside quantum/keymap_introspection.c, next to its
+ * weak default lookup in keymaps[], so the overrides can't be in keymap.c:
+ * they are in this file, added by rules.mk. keymaps[] is then only used by
+ * QMK's default lookup, which nothing calls, and the linker leaves both out
+ * (QMK builds with -ffunction-sections -fdata-sections and --gc-sections).
+ */
+uint8_t keymap_layer_count(void) {
+    return KKB_TABLE_LAYER_COUNT; // Checked against keymap_sparse.h in keymap.c
+}
+
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    return kkb_sparse_keycode_at(layer_num, row, column);
+}
+#endif
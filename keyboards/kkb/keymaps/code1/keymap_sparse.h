@@ -0,0 +1,108 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// GENERATED FILE - DO NOT EDIT
+// Generated by tools/keymap_compiler.py from keymap.c (layers sha256: 2c1edaa2f6d9641a)
+
+#pragma once
+
+#define KKB_SPARSE_LAYER_COUNT 10
+#define KKB_SPARSE_ROWS 5
+#define KKB_SPARSE_COLS 16
+#define KKB_SPARSE_WORDS 3
+#define KKB_SPARSE_KEYCODE_COUNT 223
+
+// Flash (bytes) of the dense keymaps[] array and of these tables
+#define KKB_SPARSE_DENSE_BYTES 1600
+#define KKB_SPARSE_BYTES 746
+
+// clang-format off
+// Matrix positions (row * cols + col) with a keycode in kkb_sparse_keycodes
+static const uint32_t PROGMEM kkb_sparse_present[KKB_SPARSE_LAYER_COUNT][KKB_SPARSE_WORDS] = {
+    {0xBFFFBFFF, 0xEFFFAFFF, 0x0000FC47}, // L0: __BASE
+    {0x3FFFBFFF, 0xEFFF2FFF, 0x0000FC47}, // L1: __CODE
+    {0x00001FFF, 0x00FC003F, 0x00000000}, // L2: _B_FN1
+    {0x00001FFF, 0x00000000, 0x00000000}, // L3: _B_FN2
+    {0x001E0006, 0x000C000E, 0x00000000}, // L4: _C_FN1
+    {0x001E0006, 0x0000001E, 0x00000000}, // L5: _C_FN2
+    {0x00001FFE, 0x00400010, 0x00000000}, // L6: _C_FN3
+    {0xA0000001, 0x40008000, 0x0000E000}, // L7: _C_FN4
+    {0x80000000, 0x40000001, 0x00004040}, // L8: _C_CF1
+    {0x20000000, 0x00000000, 0x00000000}, // L9: _C_CF2
+};
+
+// Matrix positions of transparent keys (KC_TRNS), all others are KC_NO
+static const uint32_t PROGMEM kkb_sparse_trns[KKB_SPARSE_LAYER_COUNT][KKB_SPARSE_WORDS] = {
+    {0x00000000, 0x00000000, 0x00000000}, // L0: __BASE
+    {0x00000000, 0x00000000, 0x00000000}, // L1: __CODE
+    {0xBFFFA000, 0xEF03AFC0, 0x0000FC47}, // L2: _B_FN1
+    {0xBFFFA000, 0xEFFFAFFF, 0x0000FC47}, // L3: _B_FN2
+    {0x00000000, 0x00000000, 0x00000000}, // L4: _C_FN1
+    {0x00000000, 0x00000000, 0x00000000}, // L5: _C_FN2
+    {0x00000000, 0x20010000, 0x00000005}, // L6: _C_FN3
+    {0x00000000, 0x20010000, 0x00000005}, // L7: _C_FN4
+    {0x00000000, 0x00000000, 0x00000000}, // L8: _C_CF1
+    {0x00000000, 0x00000000, 0x00000000}, // L9: _C_CF2
+};
+
+// Index in kkb_sparse_keycodes of the first keycode of every bitmap word
+static const uint16_t PROGMEM kkb_sparse_base[KKB_SPARSE_LAYER_COUNT][KKB_SPARSE_WORDS] = {
+    {  0,  30,  59}, // L0: __BASE
+    { 69,  98, 126}, // L1: __CODE
+    {136, 149, 161}, // L2: _B_FN1
+    {161, 174, 174}, // L3: _B_FN2
+    {174, 180, 185}, // L4: _C_FN1
+    {185, 191, 195}, // L5: _C_FN2
+    {195, 207, 209}, // L6: _C_FN3
+    {209, 212, 214}, // L7: _C_FN4
+    {217, 218, 220}, // L8: _C_CF1
+    {222, 223, 223}, // L9: _C_CF2
+};
+
+// Keycodes of all layers, in layer and matrix position order
+static const uint16_t PROGMEM kkb_sparse_keycodes[KKB_SPARSE_KEYCODE_COUNT] = {
+    // L0: __BASE
+    KC_ESC, KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7,
+    KC_8, KC_9, KC_0, KC_MINS, KC_EQL, KC_BSPC, KC_DEL, KC_TAB,
+    KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I,
+    KC_O, KC_P, KC_LBRC, KC_RBRC, KC_ENT, KC_HOME, KC_CAPS, KC_A,
+    KC_S, KC_D, KC_F, KC_G, KC_H, KC_J, KC_K, KC_L,
+    KC_SCLN, KC_QUOT, KC_NUHS, KC_PGUP, KC_LSFT, KC_NUBS, KC_Z, KC_X,
+    KC_C, KC_V, KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH,
+    KC_RSFT, KC_UP, KC_PGDN, KC_LCTL, KC_LGUI, KC_LALT, KC_SPC, KC_RALT,
+    MO(_B_FN1), MO(_B_FN2), KC_LEFT, KC_DOWN, KC_RGHT,
+    // L1: __CODE
+    KC_ESC, KC_1, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7,
+    KC_8, KC_9, KC_0, KC_MINS, KC_EQL, KC_BSPC, KC_DEL, KC_TAB,
+    KC_Q, KC_W, KC_E, KC_R, KC_T, KC_Y, KC_U, KC_I,
+    KC_O, KC_P, KC_LBRC, KC_RBRC, KC_ENT, LT(_C_FN3,KC_CAPS), KC_A, KC_S,
+    KC_D, KC_F, KC_G, KC_H, KC_J, KC_K, KC_L, KC_SCLN,
+    KC_QUOT, KC_NUHS, KC_LSFT, LT(_C_FN4,KC_NUBS), KC_Z, KC_X, KC_C, KC_V,
+    KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH, KC_RSFT, KC_UP,
+    KC_RCTL, KC_LCTL, KC_LGUI, KC_LALT, KC_SPC, KC_RALT, MO(_C_FN1), MO(_C_FN2),
+    KC_LEFT, KC_DOWN, KC_RGHT,
+    // L2: _B_FN1
+    KC_GRV, KC_BRID, KC_BRIU, KC_TASK, KC_FILE, RM_VALD, RM_VALU, KC_MPRV,
+    KC_MPLY, KC_MNXT, KC_MUTE, KC_VOLD, KC_VOLU, RM_TOGG, RM_NEXT, RM_VALU,
+    RM_HUEU, RM_SATU, RM_SPDU, RM_PREV, RM_VALD, RM_HUED, RM_SATD, RM_SPDD,
+    NK_TOGG,
+    // L3: _B_FN2
+    KC_TILD, KC_F1, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7,
+    KC_F8, KC_F9, KC_F10, KC_F11, KC_F12,
+    // L4: _C_FN1
+    UC_LBRC, UC_RBRC, UC_LPRN, UC_RPRN, UC_AMPR, UC_PIPE, UC_LCBR, UC_RCBR,
+    UC_EQUA, UC_LABK, UC_RABK,
+    // L5: _C_FN2
+    UC_EXCL, UC_QUST, UC_VADD, UC_VSUB, UC_VMUL, UC_VDIV, UC_QOTE, UC_SQOT,
+    UC_SCOL, UC_COLO,
+    // L6: _C_FN3
+    KC_F1, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7, KC_F8,
+    KC_F9, KC_F10, KC_F11, KC_F12, UC_FLS, UC_BLD,
+    // L7: _C_FN4
+    TO(_C_CF1), UC_PIN, UC_ED1, UC_ED2, KC_PGUP, KC_HOME, KC_PGDN, KC_END,
+    // L8: _C_CF1
+    TG(_C_CF1), KC_CAPS, RM_VALU, MO(_C_CF2), RM_VALD,
+    // L9: _C_CF2
+    QK_BOOT,
+};
+// clang-format on
@@ -0,0 +1,45 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// GENERATED FILE - DO NOT EDIT
+// Generated by tools/keymap_compiler.py from keymap.c (layers sha256: 2c1edaa2f6d9641a)
+
+#pragma once
+
+#define KKB_TABLE_LAYER_COUNT 10
+#define KKB_TABLE_LED_COUNT 69
+#define KKB_TABLE_LED_WORDS 3
+
+// clang-format off
+// LEDs of keys with a function (keycode > KC_TRNS)
+static const uint32_t PROGMEM kkb_layer_active_mask[KKB_TABLE_LAYER_COUNT][KKB_TABLE_LED_WORDS] = {
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x0000001F}, // L0: __BASE
+    {0xEFFFFFFF, 0xFFFFF7FF, 0x0000001F}, // L1: __CODE
+    {0xE0001FFF, 0x000FC007, 0x00000000}, // L2: _B_FN1
+    {0x00001FFF, 0x00000000, 0x00000000}, // L3: _B_FN2
+    {0xC00F0006, 0x0000C001, 0x00000000}, // L4: _C_FN1
+    {0xC00F0006, 0x00000003, 0x00000000}, // L5: _C_FN2
+    {0x00001FFE, 0x00040002, 0x00000000}, // L6: _C_FN3
+    {0x10000001, 0x02000C00, 0x0000001C}, // L7: _C_FN4
+    {0x30000000, 0x42000000, 0x00000008}, // L8: _C_CF1
+    {0x00000000, 0x00000400, 0x00000000}, // L9: _C_CF2
+};
+
+// LEDs of transparent keys (KC_TRNS)
+static const uint32_t PROGMEM kkb_layer_trns_mask[KKB_TABLE_LAYER_COUNT][KKB_TABLE_LED_WORDS] = {
+    {0x00000000, 0x00000000, 0x00000000}, // L0: __BASE
+    {0x00000000, 0x00000000, 0x00000000}, // L1: __CODE
+    {0x1FFFE000, 0xFFF03FF8, 0x0000001F}, // L2: _B_FN1
+    {0xFFFFE000, 0xFFFFFFFF, 0x0000001F}, // L3: _B_FN2
+    {0x00000000, 0x00000000, 0x00000000}, // L4: _C_FN1
+    {0x00000000, 0x00000000, 0x00000000}, // L5: _C_FN2
+    {0x00000000, 0x29001000, 0x00000000}, // L6: _C_FN3
+    {0x00000000, 0x29001000, 0x00000000}, // L7: _C_FN4
+    {0x00000000, 0x00000000, 0x00000000}, // L8: _C_CF1
+    {0x00000000, 0x00000000, 0x00000000}, // L9: _C_CF2
+};
+// clang-format on
+
+// Test LED bit in a layer mask table
+#define KKB_TABLE_TEST(table, layer, led) \
+    ((pgm_read_dword(&(table)[(layer)][(led) >> 5]) >> ((led) & 31)) & 1)
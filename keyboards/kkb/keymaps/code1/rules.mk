@@ -0,0 +1,9 @@
+# Sparse keymap lookup (KKB_SPARSE_KEYMAP_ENABLE in config.h), outside keymap.c:
+# QMK compiles keymap.c inside keymap_introspection.c, next to the weak default lookup
+SRC += keymap_sparse.c
+
+# Asynchronous RGB flush (KKB_RGB_ASYNC_ENABLE in config.h): the flush thread owns the PWM frames
+RGB_MATRIX_DRIVER = custom
+
+# Burst macro output (KKB_BURST_ENABLE in config.h): character tables and serial fallback
+SEND_STRING_ENABLE = yes
@@ -2,6 +2,17 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "kkb.h"
+#include "key_recorder.h"
+#include "adaptive_debounce.h"
+#include "reactive_heat.h"
+#include "usb_suspend.h"
+#include "boot_profile.h"
+#include "tap_hold.h"
+#include "rgb_flush.h"
+#include "stall_watch.h"
+#include "burst_macro.h"
+#include "stack_watch.h"
+#include "keycode_cache.h"
 
 #ifdef RGB_MATRIX_ENABLE
 const snled27351_led_t PROGMEM g_snled27351_leds[RGB_MATRIX_LED_COUNT] = {
@@ -109,13 +120,45 @@ bool dip_switch_update_kb(uint8_t index, bool active) {
     return dip_switch_update_user(index, active);
 }
 
-// QMK: User keycodes
-bool process_record_kb(uint16_t keycode, keyrecord_t *record) {
+// QMK: Before tap-hold processing
+bool pre_process_record_kb(uint16_t keycode, keyrecord_t *record) {
+    kkb_stall_enter(KKB_STALL_KEY_EVENT);
+
+#ifdef KKB_TAP_HOLD_ENABLE
+    if (!kkb_tap_hold_process(keycode, record)) {
+        kkb_stall_leave();
+        return false;
+    }
+#endif
+
+    if (!pre_process_record_user(keycode, record)) {
+        kkb_stall_leave();
+        return false;
+    }
+    return true;
+}
+
+// Keyboard keycodes, then the keymap's
+static bool process_record_kkb(uint16_t keycode, keyrecord_t *record) {
+#ifdef KKB_REACTIVE_ENABLE
+    kkb_reactive_key_event(record->event.key.row, record->event.key.col, record->event.pressed);
+#endif
+
+#if defined(RGB_MATRIX_ENABLE)
+    // RM_* before the deferred init would be overwritten by its RGB setup and the keymap's eeconfig reads
+    if (IS_RGB_MATRIX_KEYCODE(keycode) && !kkb_boot_deferred_done()) {
+        return false;
+    }
+#endif
+
     switch (keycode) {
         case KC_TASK:
         case KC_FILE:
         case KC_SNAP:
         case KC_CTANA:
+#ifdef KKB_BURST_ENABLE
+            kkb_burst_combo(key_comb_list[keycode - KC_TASK].keycode, key_comb_list[keycode - KC_TASK].len, record->event.pressed);
+#else
             if (record->event.pressed) {
                 for (uint8_t i = 0; i < key_comb_list[keycode - KC_TASK].len; i++)
                     register_code(key_comb_list[keycode - KC_TASK].keycode[i]);
@@ -123,12 +166,90 @@ bool process_record_kb(uint16_t keycode, keyrecord_t *record) {
                 for (int8_t i = key_comb_list[keycode - KC_TASK].len - 1; i >= 0; i--)
                     unregister_code(key_comb_list[keycode - KC_TASK].keycode[i]);
             }
+#endif
+            return false;
+
+#ifdef KKB_BURST_ENABLE
+        case KC_BRST:
+            if (record->event.pressed) {
+                kkb_burst_benchmark();
+            }
+            return false;
+#endif
+
+#ifdef KKB_KEY_RECORDER_ENABLE
+        case KC_RDMP:
+            if (record->event.pressed) {
+                key_recorder_dump();
+                key_recorder_clear();
+            }
+            return false;
+#endif
+
+        case KC_DBNC:
+            if (record->event.pressed) {
+                kkb_debounce_dump_stats();
+            }
+            return false;
+
+        case KC_DIAG:
+            if (record->event.pressed) {
+                kkb_boot_dump();
+                kkb_suspend_dump_stats();
+#ifdef KKB_TAP_HOLD_ENABLE
+                kkb_tap_hold_dump_stats();
+#endif
+#if defined(RGB_MATRIX_ENABLE) && defined(KKB_RGB_ASYNC_ENABLE)
+                kkb_rgb_flush_dump_stats();
+#endif
+#ifdef KKB_STALL_WATCH_ENABLE
+                kkb_stall_dump();
+#endif
+#ifdef KKB_STACK_WATCH_ENABLE
+                kkb_stack_dump();
+#endif
+#ifdef KKB_KEYCODE_CACHE_ENABLE
+                kkb_keycode_cache_dump();
+#endif
+            }
             return false;
     }
 
     return process_record_user(keycode, record);
 }
 
+// QMK: User keycodes
+bool process_record_kb(uint16_t keycode, keyrecord_t *record) {
+    if (!process_record_kkb(keycode, record)) {
+        // Handled here: QMK does not call post_process_record_kb(), end the key event section
+        kkb_stall_leave();
+        return false;
+    }
+    return true;
+}
+
+// QMK: After the key event was processed (not called when pre_process_record or process_record returned false).
+// Keycodes QMK handles after process_record_kb() (RM_*, UC_*) leave the section open until the next section or scan
+void post_process_record_kb(uint16_t keycode, keyrecord_t *record) {
+    post_process_record_user(keycode, record);
+    kkb_stall_leave();
+}
+
+// QMK: Matrix scan (after debounce)
+void matrix_scan_kb(void) {
+    kkb_suspend_scan();
+#if defined(RGB_MATRIX_ENABLE) && defined(KKB_RGB_ASYNC_ENABLE)
+    kkb_rgb_flush_scan();
+#endif
+    matrix_scan_user();
+}
+
+// QMK: Before the matrix is initialised
+void keyboard_pre_init_kb(void) {
+    kkb_stack_paint();
+    keyboard_pre_init_user();
+}
+
 // QMK: Initialization
 void keyboard_post_init_kb(void) {
     dip_switch_read(true);
@@ -143,15 +264,51 @@ void keyboard_post_init_kb(void) {
 #pragma GCC diagnostic pop
 
 #if defined(RGB_MATRIX_ENABLE)
-    rgb_matrix_enable();
-    rgb_matrix_mode(RGB_MATRIX_SOLID_COLOR);
-    rgb_matrix_sethsv(0, 0, 200);
+    // Dark until the deferred init
+    rgb_matrix_disable_noeeprom();
 #endif
 
+    kkb_boot_post_init();
+    kkb_stall_init();
     keyboard_post_init_user();
 }
 
+// Deferred initialisation, after USB enumeration (see boot_profile.h)
+void keyboard_deferred_init_kb(void) {
+#if defined(RGB_MATRIX_ENABLE)
+    kkb_rgb_flush_start();
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    rgb_matrix_sethsv_noeeprom(0, 0, 200);
+    rgb_matrix_enable_noeeprom();
+#endif
+
+    keyboard_deferred_init_user();
+}
+
+#if defined(RGB_MATRIX_ENABLE)
+// QMK: RGB frame rendered
+bool rgb_matrix_indicators_kb(void) {
+    kkb_boot_mark(KKB_BOOT_FIRST_FRAME);
+
+    kkb_stall_enter(KKB_STALL_RGB_INDICATORS);
+    bool result = rgb_matrix_indicators_user();
+    kkb_stall_leave();
+    return result;
+}
+
+// QMK: RGB frame rendered, per LED range
+bool rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max) {
+    kkb_stall_enter(KKB_STALL_RGB_INDICATORS);
+    bool result = rgb_matrix_indicators_advanced_user(led_min, led_max);
+    kkb_stall_leave();
+    return result;
+}
+#endif
+
 // QMK: Background tasks
 void housekeeping_task_kb(void) {
+    kkb_stall_enter(KKB_STALL_HOUSEKEEPING);
+    kkb_boot_task();
     housekeeping_task_user();
+    kkb_stall_leave();
 }
@@ -8,4 +8,13 @@
 /**
 * @brief Custom keycodes as default firmware (probably)
 */
-enum custom_keycodes { KC_TASK = QK_USER_0, KC_FILE, KC_SNAP, KC_CTANA };
+enum custom_keycodes {
+    KC_TASK = QK_USER_0,
+    KC_FILE,
+    KC_SNAP,
+    KC_CTANA,
+    KC_RDMP, // Dump key event recorder to console (KKB_KEY_RECORDER_ENABLE)
+    KC_DBNC, // Dump per-key debounce statistics to console
+    KC_DIAG, // Dump diagnostics counters to console (boot milestones, suspend/resume, tap-hold, RGB flush, stalls, stacks, keycode cache)
+    KC_BRST, // Type the burst output benchmark text, print the times to console (KKB_BURST_ENABLE)
+};
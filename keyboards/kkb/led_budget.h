@@ -0,0 +1,55 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief LED current budget (opt-in, define KKB_LED_BUDGET_ENABLE in config.h)
+ *
+ * The LED current is estimated from the PWM values: a channel draws its
+ * full-scale current (set by the SNLED27351 current tune) times PWM / 255.
+ * The budget is converted to a PWM sum at compile time, and the flush keeps
+ * a running sum of the frame (updated in set_color), so a frame under
+ * budget costs one comparison. A frame over budget is scaled down as a
+ * whole by a Q8 factor before it is sent; the rendered frame is kept
+ * unscaled.
+ *
+ * Needs KKB_RGB_ASYNC_ENABLE (the PWM frames are owned by rgb_flush.c).
+ */
+
+// Total LED current allowed (mA)
+#ifndef KKB_LED_BUDGET_MA
+#    define KKB_LED_BUDGET_MA 400
+#endif
+
+// Full-scale current of one channel (uA): 156.25 uA per current tune step (0x38: 8.75 mA)
+#ifndef KKB_LED_CHANNEL_UA
+#    ifdef M_TV
+#        define KKB_LED_CHANNEL_UA ((M_TV) * 625UL / 4)
+#    else
+#        define KKB_LED_CHANNEL_UA (0xFF * 625UL / 4) // SNLED27351 driver default tune
+#    endif
+#endif
+
+// Budget as a sum of PWM values
+#define KKB_LED_BUDGET_PWM ((uint32_t)KKB_LED_BUDGET_MA * 1000UL * 255UL / KKB_LED_CHANNEL_UA)
+
+// Estimated current (mA) of a PWM sum
+#define KKB_LED_PWM_TO_MA(pwm) ((uint32_t)(pwm) * KKB_LED_CHANNEL_UA / 255UL / 1000UL)
+
+// Scale factor in 1/256 bringing a PWM sum within the budget, 256 when under budget
+static inline uint16_t kkb_led_budget_factor(uint32_t total) {
+    if (total <= KKB_LED_BUDGET_PWM) {
+        return 256;
+    }
+    return (uint16_t)((KKB_LED_BUDGET_PWM << 8) / total);
+}
+
+// Scale PWM values, rounded down: the scaled sum stays within the budget
+static inline void kkb_led_budget_scale(uint8_t *pwm, uint16_t count, uint16_t factor) {
+    for (uint16_t i = 0; i < count; i++) {
+        pwm[i] = (uint8_t)((pwm[i] * factor) >> 8);
+    }
+}
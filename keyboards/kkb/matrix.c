@@ -3,51 +3,22 @@
 
 #include "quantum.h"
 #include "matrix.h"
-
-// HC595 shift register pins
-#define HC595_STCP B0
-#define HC595_SHCP A1
-#define HC595_DS A7
+#include "key_recorder.h"
+#include "usb_suspend.h"
+#include "boot_profile.h"
+#include "hc595_matrix.h"
+#include "stall_watch.h"
 
 static pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
 static pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
 
-static inline void HC595_delay(uint16_t n) {
-    while (n-- > 0) {
-        asm volatile("nop" ::: "memory");
-    }
-}
+// USB suspend: all columns driven, rows wake on EXTI
+static bool matrix_wake_mode = false;
 
 // Disable 'int-to-pointer-cast' warning (this entire file)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
 
-// Write to HC595
-static void HC595_output(uint16_t data) {
-    uint8_t i;
-    uint8_t n = 1;
-
-    for (i = 16; i > 0; i--) {
-        writePinLow(HC595_SHCP);
-
-        if (data & 0x8000) {
-            writePinHigh(HC595_DS);
-        } else {
-            writePinLow(HC595_DS);
-        }
-
-        data <<= 1;
-        HC595_delay(n);
-        writePinHigh(HC595_SHCP);
-        HC595_delay(n);
-    }
-
-    HC595_delay(n);
-    writePinLow(HC595_STCP);
-    HC595_delay(n);
-    writePinHigh(HC595_STCP);
-}
-
 // Configure pin to output, drive low
 static inline void setPinOutput_writeLow_atomic(pin_t pin) {
     ATOMIC_BLOCK_FORCEON {
@@ -74,49 +45,89 @@ static inline uint8_t readMatrixPin(pin_t pin) {
 
 // Select column (GPIO or shift-register)
 static bool select_col(uint8_t col) {
-    pin_t pin = col_pins[col];
-
-    // Column 0: GPIO directly
-    if (col == 0) {
+    if (HC595_IS_GPIO_COL(col)) {
+        pin_t pin = col_pins[col];
         if (pin != NO_PIN) {
             setPinOutput_writeLow_atomic(pin);
             return true;
         }
-    } else {
-        // Columns > 0: Shift registers
-        HC595_output(~(0x01 << (col - 1)));
-        return true;
+        return false;
     }
-    return false;
+
+    hc595_write(hc595_col_data(col));
+    return true;
 }
 
-// Deselect column ( GPIO or shift-register)
+// Deselect column (GPIO or shift-register)
 static void unselect_col(uint8_t col) {
-    pin_t pin = col_pins[col];
-
-    // Column 0: GPIO directly
-    if (col == 0) {
+    if (HC595_IS_GPIO_COL(col)) {
+        pin_t pin = col_pins[col];
         if (pin != NO_PIN) {
             setPinInput_writeHigh_atomic(pin);
         }
-    } else {
-        // Columns > 0: Shift registers
-        if (col >= MATRIX_COLS - 1) {
-            HC595_output(0xFFFF);
-        }
+    } else if (col >= MATRIX_COLS - 1) {
+        // Shift-register columns replace each other, deselect after the last
+        hc595_write(HC595_NONE);
     }
 }
 
 // Deselect all columns
 static void unselect_cols(void) {
-    if (col_pins[0] != NO_PIN) {
-        setPinInput_writeHigh_atomic(col_pins[0]);
+    for (uint8_t col = 0; col < HC595_GPIO_COLS; col++) {
+        if (col_pins[col] != NO_PIN) {
+            setPinInput_writeHigh_atomic(col_pins[col]);
+        }
+    }
+    hc595_write(HC595_NONE);
+}
+
+// Select all columns (any pressed key pulls its row low)
+static void select_cols(void) {
+    for (uint8_t col = 0; col < HC595_GPIO_COLS; col++) {
+        if (col_pins[col] != NO_PIN) {
+            setPinOutput_writeLow_atomic(col_pins[col]);
+        }
+    }
+    hc595_write(HC595_ALL);
+}
+
+// Row EXTI callback (ISR)
+static void row_wake_callback(void *arg) {
+    (void)arg;
+    kkb_suspend_wake_edge();
+}
+
+// Enter wake mode: drive all columns, park the HC595 pins, enable row EXTI
+void matrix_suspend_kkb(void) {
+    select_cols();
+    hc595_park();
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (row_pins[row] != NO_PIN) {
+            palEnableLineEvent(row_pins[row], PAL_EVENT_MODE_FALLING_EDGE);
+            palSetLineCallback(row_pins[row], row_wake_callback, NULL);
+        }
+    }
+
+    matrix_wake_mode = true;
+}
+
+// Leave wake mode: disable row EXTI, deselect all columns
+void matrix_resume_kkb(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (row_pins[row] != NO_PIN) {
+            palDisableLineEvent(row_pins[row]);
+        }
     }
-    HC595_output(0xFFFF);
+
+    matrix_wake_mode = false;
+    unselect_cols();
 }
 
 // QMK: Matrix init
 void matrix_init_custom(void) {
+    kkb_boot_mark(KKB_BOOT_MATRIX_INIT);
+
     // Initialize row pins as input with pullup
     for (uint8_t x = 0; x < MATRIX_ROWS; x++) {
         if (row_pins[x] != NO_PIN) {
@@ -125,16 +136,18 @@ void matrix_init_custom(void) {
     }
 
     // Initialize HC595 control pins
-    setPinOutput(HC595_DS);
-    setPinOutput(HC595_STCP);
-    setPinOutput(HC595_SHCP);
+    hc595_init();
 
     // Deselect all columns
     unselect_cols();
+
+#ifdef KKB_KEY_RECORDER_ENABLE
+    key_recorder_init();
+#endif
 }
 
-// QMK: Matrix scan
-bool matrix_scan_custom(matrix_row_t *raw) {
+// Scan all columns
+static bool matrix_scan_cols(matrix_row_t *raw) {
     bool hasChanged = false;
     // Columns
     for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
@@ -159,4 +172,69 @@ bool matrix_scan_custom(matrix_row_t *raw) {
     return hasChanged;
 }
 
+// All columns selected: true when no row is pulled low, no key is pressed
+static bool matrix_rows_idle(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (readMatrixPin(row_pins[row]) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// No key down in the last scan: probe all columns at once, full scan only when a row is low
+static bool matrix_scan_idle(matrix_row_t *raw) {
+    select_cols();
+    wait_us(1); // Settle
+    bool idle = matrix_rows_idle();
+    unselect_cols();
+
+    // raw is all zero, nothing changed
+    return idle ? false : matrix_scan_cols(raw);
+}
+
+// Wake mode: read the rows with all columns driven, scan only when a row is low
+static bool matrix_scan_wake(matrix_row_t *raw) {
+    bool hasChanged = false;
+
+    if (!matrix_rows_idle()) {
+        unselect_cols();
+        hasChanged = matrix_scan_cols(raw);
+        select_cols();
+        hc595_park();
+        return hasChanged;
+    }
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        hasChanged |= (raw[row] != 0);
+        raw[row] = 0;
+    }
+    return hasChanged;
+}
+
+// QMK: Matrix scan
+bool matrix_scan_custom(matrix_row_t *raw) {
+    kkb_boot_mark(KKB_BOOT_FIRST_SCAN);
+    kkb_stall_scan();
+
+    bool hasChanged;
+    if (matrix_wake_mode) {
+        hasChanged = matrix_scan_wake(raw);
+    } else {
+        bool keys_down = false;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            keys_down |= (raw[row] != 0);
+        }
+        hasChanged = keys_down ? matrix_scan_cols(raw) : matrix_scan_idle(raw);
+    }
+
+#ifdef KKB_KEY_RECORDER_ENABLE
+    if (hasChanged) {
+        key_recorder_scan(raw);
+    }
+#endif
+
+    return hasChanged;
+}
+
 #pragma GCC diagnostic pop
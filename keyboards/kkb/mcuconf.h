@@ -14,3 +14,7 @@
 // Enable I2C1 for RGB driver
 #undef STM32_I2C_USE_I2C1
 #define STM32_I2C_USE_I2C1 TRUE
+
+// DMA transfers, the flush thread sleeps while a frame is on the bus (rgb_flush.c)
+#undef STM32_I2C_USE_DMA
+#define STM32_I2C_USE_DMA TRUE
@@ -0,0 +1,12 @@
+# Included after the keymap rules.mk: settings that depend on it
+
+# Custom RGB matrix driver (asynchronous flush, rgb_flush.c): QMK's SNLED27351 driver code without
+# its driver definition, and the LED count its header only defines for RGB_MATRIX_DRIVER = snled27351
+ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
+    ifeq ($(strip $(RGB_MATRIX_DRIVER)), custom)
+        COMMON_VPATH += $(DRIVER_PATH)/led
+        SRC += snled27351.c
+        I2C_DRIVER_REQUIRED = yes
+        OPT_DEFS += -DSNLED27351_LED_COUNT=RGB_MATRIX_LED_COUNT
+    endif
+endif
@@ -0,0 +1,67 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "reactive_heat.h"
+
+#ifdef KKB_REACTIVE_ENABLE
+
+uint8_t g_kkb_reactive_heat[RGB_MATRIX_LED_COUNT];
+
+// Decay in 8.8 fixed point heat units, remainder kept between calls
+#    define KKB_REACTIVE_DECAY_Q8_PER_MS ((255UL << 8) / KKB_REACTIVE_DECAY_MS)
+
+static uint16_t reactive_last_time  = 0;
+static uint16_t reactive_decay_frac = 0;
+static bool     reactive_any_heat   = false;
+
+// Raise the heat of the key's LED on press
+void kkb_reactive_key_event(uint8_t row, uint8_t col, bool pressed) {
+    if (!pressed || row >= MATRIX_ROWS || col >= MATRIX_COLS) {
+        return;
+    }
+
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (led == NO_LED) {
+        return;
+    }
+
+    uint16_t heat            = g_kkb_reactive_heat[led] + KKB_REACTIVE_HIT;
+    g_kkb_reactive_heat[led] = heat > UINT8_MAX ? UINT8_MAX : (uint8_t)heat;
+
+    if (!reactive_any_heat) {
+        // Start decaying from now, not from the last (idle) call
+        reactive_last_time  = timer_read();
+        reactive_decay_frac = 0;
+        reactive_any_heat   = true;
+    }
+}
+
+// Decay all LEDs by the time passed since the last call (call at least once per frame)
+void kkb_reactive_decay(void) {
+    if (!reactive_any_heat) {
+        return;
+    }
+
+    uint16_t now       = timer_read();
+    uint16_t elapsed   = TIMER_DIFF_16(now, reactive_last_time);
+    reactive_last_time = now;
+
+    uint32_t decay_q8   = (uint32_t)elapsed * KKB_REACTIVE_DECAY_Q8_PER_MS + reactive_decay_frac;
+    reactive_decay_frac = decay_q8 & 0xFF;
+    uint8_t step        = decay_q8 >= (255UL << 8) ? 255 : (uint8_t)(decay_q8 >> 8);
+
+    if (step == 0) {
+        return;
+    }
+
+    bool any_heat = false;
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint8_t heat           = g_kkb_reactive_heat[i];
+        heat                   = heat > step ? heat - step : 0;
+        g_kkb_reactive_heat[i] = heat;
+        any_heat |= heat != 0;
+    }
+    reactive_any_heat = any_heat;
+}
+
+#endif
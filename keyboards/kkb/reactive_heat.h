@@ -0,0 +1,47 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief Reactive key heat (opt-in, define KKB_REACTIVE_ENABLE in config.h)
+ *
+ * One 8-bit heat value per LED, raised on key presses and decayed linearly
+ * over time in integer arithmetic. Replaces the matrix sized framebuffer of
+ * typing_heatmap, and the hit tracker of the solid_reactive effects, which
+ * need RGB_MATRIX_FRAMEBUFFER_EFFECTS / RGB_MATRIX_KEYPRESSES.
+ *
+ * Used by the KKB_REACTIVE effect (rgb_matrix_kb.inc), and can be blended
+ * into keymap indicator colors with kkb_reactive_heat().
+ */
+
+// Heat added per key press (255 = reactive, lower values build up as a heatmap)
+#ifndef KKB_REACTIVE_HIT
+#    define KKB_REACTIVE_HIT 255
+#endif
+
+// Time (ms) for a key to fade from full heat to zero
+#ifndef KKB_REACTIVE_DECAY_MS
+#    define KKB_REACTIVE_DECAY_MS 600
+#endif
+
+#ifdef KKB_REACTIVE_ENABLE
+
+extern uint8_t g_kkb_reactive_heat[RGB_MATRIX_LED_COUNT];
+
+void kkb_reactive_key_event(uint8_t row, uint8_t col, bool pressed);
+void kkb_reactive_decay(void);
+
+// Heat of an LED (0-255)
+static inline uint8_t kkb_reactive_heat(uint8_t led) {
+    return g_kkb_reactive_heat[led];
+}
+
+// Blend one color channel towards a target by heat, (a * (255 - heat) + b * heat) / 256
+static inline uint8_t kkb_reactive_blend(uint8_t from, uint8_t to, uint8_t heat) {
+    return (uint8_t)(((uint16_t)from * (uint8_t)(255 - heat) + (uint16_t)to * heat + 255) >> 8);
+}
+
+#endif
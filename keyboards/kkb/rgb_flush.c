@@ -0,0 +1,273 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_flush.h"
+#include "stall_watch.h"
+
+#ifdef RGB_MATRIX_ENABLE
+
+#    include "snled27351.h"
+
+#    if defined(KKB_LED_BUDGET_ENABLE) && !defined(KKB_RGB_ASYNC_ENABLE)
+#        error "KKB_LED_BUDGET_ENABLE needs KKB_RGB_ASYNC_ENABLE"
+#    endif
+#    if defined(KKB_RGB_ASYNC_ENABLE) && defined(RGB_MATRIX_SNLED27351)
+#        error "KKB_RGB_ASYNC_ENABLE needs RGB_MATRIX_DRIVER = custom in the keymap rules.mk"
+#    endif
+
+#    ifdef KKB_RGB_ASYNC_ENABLE
+
+#        include "i2c_master.h"
+#        include "print.h"
+#        include "led_budget.h"
+#        include "cycle_time.h"
+
+// As QMK's driver, which keeps them in snled27351.c
+#        ifndef SNLED27351_PWM_REGISTER_COUNT
+#            define SNLED27351_PWM_REGISTER_COUNT 192
+#        endif
+#        ifndef SNLED27351_I2C_TIMEOUT
+#            define SNLED27351_I2C_TIMEOUT 100
+#        endif
+
+typedef uint8_t pwm_frame_t[SNLED27351_DRIVER_COUNT][SNLED27351_PWM_REGISTER_COUNT];
+
+static const uint8_t flush_addresses[SNLED27351_DRIVER_COUNT] = {
+    SNLED27351_I2C_ADDRESS_1,
+#        ifdef SNLED27351_I2C_ADDRESS_2
+    SNLED27351_I2C_ADDRESS_2,
+#            ifdef SNLED27351_I2C_ADDRESS_3
+    SNLED27351_I2C_ADDRESS_3,
+#                ifdef SNLED27351_I2C_ADDRESS_4
+    SNLED27351_I2C_ADDRESS_4,
+#                endif
+#            endif
+#        endif
+};
+
+// Double-buffered PWM frame: render_frame is written by the renderer, the other one is sent
+static pwm_frame_t      frames[2];
+static uint8_t          render_frame  = 0;
+static bool             render_dirty  = false;
+static volatile uint8_t sent_frame;
+static volatile bool    flush_busy    = false; // Frame handed to the thread, until sent
+static volatile bool    flush_failed  = false; // I2C error, send the next frame even if unchanged
+static volatile bool    flush_seen    = false; // A frame was sent since the last scan
+static bool             flush_started = false; // Drivers set up (deferred init), nothing is sent before
+
+static kkb_rgb_flush_stats_t flush_stats;
+static uint32_t              last_scan_cycles;
+
+#        ifdef KKB_LED_BUDGET_ENABLE
+static uint32_t render_total   = 0;   // Sum of the PWM values of the render frame
+static uint32_t budget_peak    = 0;   // Highest sum flushed
+static uint32_t budget_limited = 0;   // Frames scaled down
+static uint16_t budget_factor  = 256; // Last scale factor (1/256)
+#        endif
+
+static THD_WORKING_AREA(flush_thread_wa, 512); // i2c_write_register() copies the frame on the stack
+static BSEMAPHORE_DECL(flush_sem, true);
+static MUTEX_DECL(flush_mutex);
+
+// Send one frame, all drivers
+static bool flush_send(const pwm_frame_t *frame) {
+    bool ok = true;
+
+    chMtxLock(&flush_mutex);
+    for (uint8_t i = 0; i < SNLED27351_DRIVER_COUNT; i++) {
+        snled27351_select_page(i, SNLED27351_COMMAND_PWM);
+        if (i2c_write_register(flush_addresses[i] << 1, 0, (*frame)[i], SNLED27351_PWM_REGISTER_COUNT, SNLED27351_I2C_TIMEOUT) != I2C_STATUS_SUCCESS) {
+            ok = false;
+        }
+    }
+    chMtxUnlock(&flush_mutex);
+
+    return ok;
+}
+
+// Flush thread: sleeps until a frame is handed over, and while it is on the bus
+static THD_FUNCTION(flush_thread_func, arg) {
+    (void)arg;
+    chRegSetThreadName("rgb_flush");
+
+    while (true) {
+        chBSemWait(&flush_sem);
+
+        uint32_t start = DWT->CYCCNT;
+        flush_seen     = true;
+
+        if (flush_send(&frames[sent_frame])) {
+            flush_stats.frames++;
+        } else {
+            flush_stats.dropped++;
+            flush_failed = true;
+        }
+        kkb_update_time(&flush_stats.flush_us_last, &flush_stats.flush_us_max, start);
+
+        flush_busy = false;
+    }
+}
+
+// QMK (keyboard_init): only the flush thread, the drivers are set up by the deferred init
+static void kkb_rgb_init(void) {
+    chThdCreateStatic(flush_thread_wa, sizeof(flush_thread_wa), KKB_RGB_FLUSH_PRIO, flush_thread_func, NULL);
+}
+
+// Deferred init: I2C and the drivers. Frames rendered before are sent with the first flush after
+void kkb_rgb_flush_start(void) {
+#        ifdef KKB_I2C_FAST_MODE_PLUS
+    // Fast-mode Plus drive on the I2C1 pins
+    rccEnableAPB2(RCC_APB2ENR_SYSCFGEN, true);
+    SYSCFG->CFGR1 |= SYSCFG_CFGR1_I2C1_FMP;
+#        endif
+
+    snled27351_init_drivers();
+    flush_started = true;
+}
+
+bool kkb_rgb_flush_started(void) {
+    return flush_started;
+}
+
+static void kkb_rgb_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index < 0 || index >= SNLED27351_LED_COUNT) {
+        return;
+    }
+
+    snled27351_led_t led;
+    memcpy_P(&led, &g_snled27351_leds[index], sizeof(led));
+
+    uint8_t *pwm = frames[render_frame][led.driver];
+    if (pwm[led.r] == red && pwm[led.g] == green && pwm[led.b] == blue) {
+        return;
+    }
+#        ifdef KKB_LED_BUDGET_ENABLE
+    render_total += (uint32_t)red + green + blue;
+    render_total -= (uint32_t)pwm[led.r] + pwm[led.g] + pwm[led.b];
+#        endif
+    pwm[led.r]   = red;
+    pwm[led.g]   = green;
+    pwm[led.b]   = blue;
+    render_dirty = true;
+}
+
+static void kkb_rgb_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < SNLED27351_LED_COUNT; i++) {
+        kkb_rgb_set_color(i, red, green, blue);
+    }
+}
+
+#        ifdef KKB_LED_BUDGET_ENABLE
+// Scale the frame to be sent when over the current budget
+static void budget_limit(pwm_frame_t *frame) {
+    if (render_total > budget_peak) {
+        budget_peak = render_total;
+    }
+    budget_factor = kkb_led_budget_factor(render_total);
+    if (budget_factor < 256) {
+        kkb_led_budget_scale(&(*frame)[0][0], sizeof(pwm_frame_t), budget_factor);
+        budget_limited++;
+    }
+}
+#        endif
+
+// QMK: Frame rendered. Hand it to the flush thread, never waits
+static void kkb_rgb_flush(void) {
+    if (!flush_started || (!render_dirty && !flush_failed)) {
+        return;
+    }
+
+    kkb_stall_enter(KKB_STALL_RGB_FLUSH);
+    if (flush_busy) {
+        // Previous frame still on the bus, this one goes with the next flush (only the thread clears flush_busy)
+        flush_stats.merged++;
+        kkb_stall_leave();
+        return;
+    }
+
+    // The other frame is free: it continues the rendering, the rendered one is sent
+    uint8_t frame = render_frame;
+    memcpy(frames[frame ^ 1], frames[frame], sizeof(pwm_frame_t));
+#        ifdef KKB_LED_BUDGET_ENABLE
+    budget_limit(&frames[frame]);
+#        endif
+
+    chSysLock();
+    sent_frame   = frame;
+    render_frame = frame ^ 1;
+    flush_busy   = true;
+    flush_failed = false;
+    chBSemSignalI(&flush_sem);
+    chSchRescheduleS();
+    chSysUnlock();
+
+    render_dirty = false;
+    kkb_stall_leave();
+}
+
+// Matrix scan (matrix_scan_kb): longest gap between scans while frames are sent
+void kkb_rgb_flush_scan(void) {
+    uint32_t now = DWT->CYCCNT;
+
+    if (flush_busy || flush_seen) {
+        flush_seen   = false;
+        uint32_t gap = CYCLES_TO_US(now - last_scan_cycles);
+        if (gap > flush_stats.scan_gap_us_max) {
+            flush_stats.scan_gap_us_max = gap;
+        }
+    }
+    last_scan_cycles = now;
+}
+
+// Exclusive use of the drivers from the main loop (suspend, resume)
+void kkb_rgb_flush_lock(void) {
+    chMtxLock(&flush_mutex);
+}
+
+void kkb_rgb_flush_unlock(void) {
+    chMtxUnlock(&flush_mutex);
+}
+
+// Copy the counters
+void kkb_rgb_flush_get_stats(kkb_rgb_flush_stats_t *stats) {
+    *stats = flush_stats;
+}
+
+// Print the counters
+void kkb_rgb_flush_dump_stats(void) {
+    // frames merged dropped flush_us_last flush_us_max scan_gap_us_max
+    uprintf("RGBF %lu %lu %lu %lu %lu %lu\n", (unsigned long)flush_stats.frames, (unsigned long)flush_stats.merged, (unsigned long)flush_stats.dropped, (unsigned long)flush_stats.flush_us_last, (unsigned long)flush_stats.flush_us_max, (unsigned long)flush_stats.scan_gap_us_max);
+#        ifdef KKB_LED_BUDGET_ENABLE
+    // budget_ma peak_ma limited_frames last_factor
+    uprintf("LEDP %lu %lu %lu %u\n", (unsigned long)KKB_LED_BUDGET_MA, (unsigned long)KKB_LED_PWM_TO_MA(budget_peak), (unsigned long)budget_limited, budget_factor);
+#        endif
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = kkb_rgb_init,
+    .flush         = kkb_rgb_flush,
+    .set_color     = kkb_rgb_set_color,
+    .set_color_all = kkb_rgb_set_color_all,
+};
+
+#    elif !defined(RGB_MATRIX_SNLED27351)
+
+// Custom driver without KKB_RGB_ASYNC_ENABLE (otherwise QMK defines the driver)
+
+// QMK: Frame rendered, blocking I2C transfers
+static void kkb_rgb_flush(void) {
+    kkb_stall_enter(KKB_STALL_RGB_FLUSH);
+    snled27351_flush();
+    kkb_stall_leave();
+}
+
+// QMK's SNLED27351 driver, flushed from the main loop
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = snled27351_init_drivers,
+    .flush         = kkb_rgb_flush,
+    .set_color     = snled27351_set_color,
+    .set_color_all = snled27351_set_color_all,
+};
+
+#    endif
+#endif
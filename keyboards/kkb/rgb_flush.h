@@ -0,0 +1,76 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief SNLED27351 RGB matrix driver with asynchronous flush
+ *
+ * The keyboard uses QMK's SNLED27351 driver (keyboard.json). A keymap that
+ * defines KKB_RGB_ASYNC_ENABLE sets RGB_MATRIX_DRIVER = custom in its
+ * rules.mk, so the PWM frames can be owned here (post_rules.mk adds the
+ * SNLED27351 driver code).
+ *
+ * With KKB_RGB_ASYNC_ENABLE (opt-in, config.h), the renderer writes into one
+ * of two PWM frames. A flush swaps the frames (under chSysLock) and wakes the
+ * flush thread, which sends the other frame over I2C1 (interrupt/DMA driven
+ * transfers), so the main loop never waits on the bus. A frame finished while
+ * the previous one is still being sent is merged into the next flush.
+ *
+ * The flush thread runs above the main loop (KKB_RGB_FLUSH_PRIO): QMK's main
+ * loop never sleeps, so a thread below it would never run. It only uses the
+ * CPU to start transfers, and sleeps while they are on the bus.
+ *
+ * QMK's rgb_matrix_init() (keyboard_init) only starts the flush thread. I2C
+ * and the drivers are set up by kkb_rgb_flush_start() in the deferred init
+ * (boot_profile.h), frames are not sent before.
+ *
+ * With KKB_LED_BUDGET_ENABLE, frames over the LED current budget are scaled
+ * down before they are sent (see led_budget.h).
+ *
+ * Fast-mode Plus (1 MHz) timing: define KKB_I2C_FAST_MODE_PLUS in the
+ * keyboard config.h.
+ *
+ * Counters are dumped with KC_DIAG.
+ */
+
+// Priority of the flush thread (main loop: NORMALPRIO)
+#ifndef KKB_RGB_FLUSH_PRIO
+#    define KKB_RGB_FLUSH_PRIO (NORMALPRIO + 1)
+#endif
+
+#if defined(RGB_MATRIX_ENABLE) && defined(KKB_RGB_ASYNC_ENABLE)
+
+/**
+ * @brief Flush counters, times in microseconds
+ */
+typedef struct {
+    uint32_t frames;          // Frames sent
+    uint32_t merged;          // Frames not sent, the previous one was still on the bus (merged into the next)
+    uint32_t dropped;         // Frames with an I2C error (sent again with the next frame)
+    uint32_t flush_us_last;   // Frame send time, all drivers
+    uint32_t flush_us_max;    //
+    uint32_t scan_gap_us_max; // Longest time between two matrix scans while a frame was sent
+} kkb_rgb_flush_stats_t;
+
+void kkb_rgb_flush_start(void);
+bool kkb_rgb_flush_started(void);
+void kkb_rgb_flush_scan(void);
+void kkb_rgb_flush_lock(void);
+void kkb_rgb_flush_unlock(void);
+void kkb_rgb_flush_get_stats(kkb_rgb_flush_stats_t *stats);
+void kkb_rgb_flush_dump_stats(void);
+
+#else
+
+// Drivers set up by QMK's rgb_matrix_init(), blocking flush from the main loop, nothing to lock
+static inline void kkb_rgb_flush_start(void) {}
+static inline bool kkb_rgb_flush_started(void) {
+    return true;
+}
+static inline void kkb_rgb_flush_lock(void) {}
+static inline void kkb_rgb_flush_unlock(void) {}
+
+#endif
@@ -1,5 +1,35 @@
 CUSTOM_MATRIX = lite
 SRC += matrix.c
+SRC += key_recorder.c
+SRC += usb_suspend.c
+SRC += boot_profile.c
+
+# Main loop stall watchdog, opt-in (KKB_STALL_WATCH_ENABLE)
+SRC += stall_watch.c
+
+# Stack high-water marks, opt-in (KKB_STACK_WATCH_ENABLE, see chconf.h)
+SRC += stack_watch.c
+
+# Per-key adaptive debounce, see adaptive_debounce.h
+DEBOUNCE_TYPE = custom
+SRC += adaptive_debounce.c
+
+# Custom RGB effects (rgb_matrix_kb.inc), reactive heat is opt-in (KKB_REACTIVE_ENABLE)
+RGB_MATRIX_CUSTOM_KB = yes
+SRC += reactive_heat.c
+
+# Asynchronous RGB flush, see rgb_flush.h (opt-in, KKB_RGB_ASYNC_ENABLE and RGB_MATRIX_DRIVER = custom
+# in the keymap, post_rules.mk adds the SNLED27351 driver code)
+SRC += rgb_flush.c
+
+# Predictive tap-hold for LT() keys, opt-in (KKB_TAP_HOLD_ENABLE)
+SRC += tap_hold.c
+
+# Burst macro output in NKRO reports, opt-in (KKB_BURST_ENABLE, with SEND_STRING_ENABLE = yes in the keymap)
+SRC += burst_macro.c
+
+# Resolved keycode cache for the active layers, opt-in (KKB_KEYCODE_CACHE_ENABLE)
+SRC += keycode_cache.c
 
 OPT_DEFS += -DCORTEX_ENABLE_WFI_IDLE=TRUE
 OPT_DEFS += -DNO_USB_STARTUP_CHECK
@@ -0,0 +1,58 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "stack_watch.h"
+
+#ifdef KKB_STACK_WATCH_ENABLE
+
+#    include "print.h"
+
+#    if (CH_DBG_FILL_THREADS != TRUE) || (CH_DBG_ENABLE_STACK_CHECK != TRUE)
+#        error "KKB_STACK_WATCH_ENABLE needs CH_DBG_FILL_THREADS and CH_DBG_ENABLE_STACK_CHECK (chconf.h)"
+#    endif
+
+// Margin below the stack pointer while painting (the painting loop's own frame)
+#    define STACK_PAINT_MARGIN 64
+
+// Linker symbols (ChibiOS rules_stacks.ld)
+extern uint8_t __main_stack_base__[], __main_stack_end__[];       // Interrupts and exceptions (MSP)
+extern uint8_t __process_stack_base__[], __process_stack_end__[]; // Main thread (PSP)
+
+static void stack_paint(uint8_t *base, uint8_t *sp) {
+    for (uint8_t *p = base; p < sp - STACK_PAINT_MARGIN; p++) {
+        *p = CH_DBG_STACK_FILL_VALUE;
+    }
+}
+
+// Stacks in use: only the part below the stack pointers is painted
+void kkb_stack_paint(void) {
+    stack_paint(__process_stack_base__, (uint8_t *)(uintptr_t)__get_PSP());
+    stack_paint(__main_stack_base__, (uint8_t *)(uintptr_t)__get_MSP());
+}
+
+static void stack_dump(const char *name, const uint8_t *base, const uint8_t *end) {
+    const uint8_t *p = base;
+    while (p < end && *p == CH_DBG_STACK_FILL_VALUE) {
+        p++;
+    }
+
+    // name size_bytes peak_bytes
+    uprintf("STACK %s %lu %lu\n", name ? name : "?", (unsigned long)(end - base), (unsigned long)(end - p));
+}
+
+// Print the high-water marks
+void kkb_stack_dump(void) {
+    stack_dump("main", __process_stack_base__, __process_stack_end__);
+    stack_dump("irq", __main_stack_base__, __main_stack_end__);
+
+    // Other threads: the working area, below the thread structure at its top
+    thread_t *tp = chRegFirstThread();
+    while (tp != NULL) {
+        if ((uint8_t *)tp->wabase != __process_stack_base__) {
+            stack_dump(chRegGetThreadNameX(tp), (const uint8_t *)tp->wabase, (const uint8_t *)tp);
+        }
+        tp = chRegNextThread(tp);
+    }
+}
+
+#endif
@@ -0,0 +1,32 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief Stack high-water marks (opt-in, define KKB_STACK_WATCH_ENABLE in config.h)
+ *
+ * Stacks are painted with CH_DBG_STACK_FILL_VALUE: the main thread and
+ * interrupt stacks below their stack pointers in keyboard_pre_init_kb(),
+ * and the working areas of the idle thread and of any thread created
+ * later by ChibiOS itself (CH_DBG_FILL_THREADS, set in chconf.h with this
+ * option, together with CH_DBG_ENABLE_STACK_CHECK for the working area
+ * bases). The high-water mark is the deepest byte that no longer holds
+ * the pattern.
+ *
+ * Dumped with KC_DIAG as STACK lines. The static RAM use (.data, .bss) by
+ * object file is printed from the build's map file by tools/ram_map.py.
+ */
+
+#ifdef KKB_STACK_WATCH_ENABLE
+
+void kkb_stack_paint(void);
+void kkb_stack_dump(void);
+
+#else
+
+static inline void kkb_stack_paint(void) {}
+
+#endif
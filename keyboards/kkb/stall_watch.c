@@ -0,0 +1,126 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "stall_watch.h"
+
+#ifdef KKB_STALL_WATCH_ENABLE
+
+#    include "usb_suspend.h"
+#    include "cycle_time.h"
+#    include "print.h"
+
+#    define STALL_LOG_MAGIC 0x4B53544CUL // "KSTL"
+
+// Persistent log, in the no-init RAM section (kept over soft resets)
+static struct {
+    uint32_t          magic;
+    uint16_t          boots;
+    uint8_t           next;  // Next entry to write
+    uint8_t           count; // Valid entries
+    kkb_stall_entry_t entries[KKB_STALL_LOG_SIZE];
+} stall_log __attribute__((section(".ram0")));
+
+static const char *const stall_section_names[KKB_STALL_SECTIONS] = {
+    "other", "key_event", "eeconfig", "rgb_indicators", "rgb_flush", "housekeeping",
+};
+
+static bool     stall_ready = false; // Log checked (post init)
+static bool     stall_armed = false; // Previous scan timestamp valid
+static uint32_t last_scan_cycles;
+
+// Open section, and the longest section since the last scan
+static uint8_t  open_section = KKB_STALL_OTHER;
+static uint32_t open_cycles;
+static uint8_t  worst_section = KKB_STALL_OTHER;
+static uint32_t worst_cycles  = 0;
+
+// Check the log left in RAM (garbage after power on), count the boot
+void kkb_stall_init(void) {
+    if (stall_log.magic != STALL_LOG_MAGIC || stall_log.next >= KKB_STALL_LOG_SIZE || stall_log.count > KKB_STALL_LOG_SIZE) {
+        memset(&stall_log, 0, sizeof(stall_log));
+        stall_log.magic = STALL_LOG_MAGIC;
+    }
+    stall_log.boots++;
+    stall_ready = true;
+}
+
+static void close_section(uint32_t now) {
+    if (open_section != KKB_STALL_OTHER) {
+        uint32_t cycles = now - open_cycles;
+        if (cycles > worst_cycles) {
+            worst_cycles  = cycles;
+            worst_section = open_section;
+        }
+        open_section = KKB_STALL_OTHER;
+    }
+}
+
+// Start of a section, ends the open one (the innermost section is kept)
+void kkb_stall_enter(uint8_t section) {
+    uint32_t now = DWT->CYCCNT;
+    close_section(now);
+    open_section = section;
+    open_cycles  = now;
+}
+
+// End of the open section
+void kkb_stall_leave(void) {
+    close_section(DWT->CYCCNT);
+}
+
+static void log_stall(uint32_t gap_us) {
+    kkb_stall_entry_t *entry = &stall_log.entries[stall_log.next];
+
+    entry->boot       = stall_log.boots;
+    entry->section    = worst_section;
+    entry->uptime_ms  = timer_read32();
+    entry->gap_us     = gap_us;
+    entry->section_us = CYCLES_TO_US(worst_cycles);
+
+    stall_log.next = (stall_log.next + 1) % KKB_STALL_LOG_SIZE;
+    if (stall_log.count < KKB_STALL_LOG_SIZE) {
+        stall_log.count++;
+    }
+}
+
+// Matrix scan (matrix_scan_custom): check the gap since the last scan
+void kkb_stall_scan(void) {
+    uint32_t now = DWT->CYCCNT;
+
+    if (kkb_suspend_state != KKB_AWAKE || !stall_ready) {
+        // Suspended (or before post init): the main loop waits on purpose
+        stall_armed = false;
+        return;
+    }
+
+    close_section(now);
+    if (stall_armed) {
+        uint32_t gap_us = CYCLES_TO_US(now - last_scan_cycles);
+        if (gap_us > KKB_STALL_BUDGET_US) {
+            log_stall(gap_us);
+        }
+    }
+
+    stall_armed      = true;
+    last_scan_cycles = now;
+    worst_section    = KKB_STALL_OTHER;
+    worst_cycles     = 0;
+}
+
+// Print the log, oldest first
+void kkb_stall_dump(void) {
+    // budget_us current_boot
+    uprintf("STALL BUDGET %lu %u\n", (unsigned long)KKB_STALL_BUDGET_US, stall_log.boots);
+
+    uint8_t index = (stall_log.next + KKB_STALL_LOG_SIZE - stall_log.count) % KKB_STALL_LOG_SIZE;
+    for (uint8_t i = 0; i < stall_log.count; i++) {
+        const kkb_stall_entry_t *entry   = &stall_log.entries[index];
+        const char              *section = entry->section < KKB_STALL_SECTIONS ? stall_section_names[entry->section] : "?";
+
+        // boot uptime_ms gap_us section section_us
+        uprintf("STALL %u %lu %lu %s %lu\n", entry->boot, (unsigned long)entry->uptime_ms, (unsigned long)entry->gap_us, section, (unsigned long)entry->section_us);
+        index = (index + 1) % KKB_STALL_LOG_SIZE;
+    }
+}
+
+#endif
@@ -0,0 +1,74 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief Main loop stall watchdog (opt-in, define KKB_STALL_WATCH_ENABLE in config.h)
+ *
+ * Measures the time between matrix_scan_custom() calls. Code that may hold
+ * the main loop is wrapped in kkb_stall_enter() / kkb_stall_leave(), and the
+ * longest section in a gap is kept. A gap over KKB_STALL_BUDGET_US is logged
+ * with that section and its time, or "other" when no instrumented section
+ * ran (QMK internals, interrupts, higher priority threads).
+ *
+ * The log is a ring of the last KKB_STALL_LOG_SIZE stalls in no-init RAM,
+ * so it survives a soft reset (QK_BOOT aborted, watchdog, NVIC reset), but
+ * not a power cycle. Entries are tagged with a boot number. Dumped with
+ * KC_DIAG as STALL lines.
+ */
+
+// Gap between matrix scans (us) above which a stall is logged
+#ifndef KKB_STALL_BUDGET_US
+#    define KKB_STALL_BUDGET_US 2000
+#endif
+
+// Logged stalls, the oldest are overwritten
+#ifndef KKB_STALL_LOG_SIZE
+#    define KKB_STALL_LOG_SIZE 8
+#endif
+
+// Instrumented sections
+enum kkb_stall_section {
+    KKB_STALL_OTHER,          // No instrumented section
+    KKB_STALL_KEY_EVENT,      // Key event processing, including the USB report sent by it
+    KKB_STALL_EECONFIG,       // eeconfig (flash emulated EEPROM) writes
+    KKB_STALL_RGB_INDICATORS, // rgb_matrix_indicators(_advanced) callbacks
+    KKB_STALL_RGB_FLUSH,      // LED frame flush or hand-off to the flush thread (custom RGB driver only)
+    KKB_STALL_HOUSEKEEPING,   // housekeeping_task callbacks, deferred init
+    KKB_STALL_SECTIONS
+};
+
+#ifdef KKB_STALL_WATCH_ENABLE
+
+_Static_assert(KKB_STALL_LOG_SIZE <= UINT8_MAX, "KKB_STALL_LOG_SIZE too large");
+
+/**
+ * @brief One logged stall
+ */
+typedef struct {
+    uint16_t boot;       // Boot number (counted while the log survives)
+    uint8_t  section;    // Longest instrumented section in the gap
+    uint32_t uptime_ms;  // timer_read32() at the end of the gap
+    uint32_t gap_us;     // Time between the two matrix scans
+    uint32_t section_us; // Time in that section
+} kkb_stall_entry_t;
+
+void kkb_stall_init(void);
+void kkb_stall_enter(uint8_t section);
+void kkb_stall_leave(void);
+void kkb_stall_scan(void);
+void kkb_stall_dump(void);
+
+#else
+
+static inline void kkb_stall_init(void) {}
+static inline void kkb_stall_enter(uint8_t section) {
+    (void)section;
+}
+static inline void kkb_stall_leave(void) {}
+static inline void kkb_stall_scan(void) {}
+
+#endif
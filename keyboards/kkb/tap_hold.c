@@ -0,0 +1,156 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "tap_hold.h"
+
+#ifdef KKB_TAP_HOLD_ENABLE
+
+#    include "print.h"
+
+// Layer-tap key state
+enum {
+    TH_IDLE,
+    TH_PENDING, // Layer on, not decided yet
+    TH_HOLD,    // Decided hold, layer on
+    TH_TAP,     // Decided tap, tap keycode registered until release
+    TH_DONE,    // Decided tap, already sent, release ignored
+};
+
+static const uint8_t tap_hold_bucket_ms[KKB_TAP_HOLD_BUCKETS - 1] = {10, 25, 50, 100, 200};
+static uint16_t      tap_hold_histogram[KKB_TH_DECISIONS][KKB_TAP_HOLD_BUCKETS];
+
+static const char *const tap_hold_decision_names[KKB_TH_DECISIONS] = {
+    "tap_flow", "tap_roll", "tap_release", "hold_key", "hold_alone",
+};
+
+// One layer-tap key is decided at a time, others go through QMK
+static struct {
+    uint8_t  state;
+    uint16_t keycode;
+    keypos_t key;
+    uint16_t press_time;
+} tap_hold = {TH_IDLE};
+
+static uint32_t last_press_time  = 0;
+static bool     last_press_valid = false;
+
+// Flow tap for a tap keycode. Not Caps Lock: a toggled lock is costly to undo,
+// and its layer is often wanted right after typing
+static inline bool tap_hold_flow_key(uint16_t tap) {
+    return tap != KC_CAPS;
+}
+
+static void record_decision(uint8_t decision, uint16_t latency) {
+    uint8_t bucket = 0;
+    while (bucket < KKB_TAP_HOLD_BUCKETS - 1 && latency >= tap_hold_bucket_ms[bucket]) {
+        bucket++;
+    }
+    if (tap_hold_histogram[decision][bucket] < UINT16_MAX) {
+        tap_hold_histogram[decision][bucket]++;
+    }
+}
+
+// Release of the layer-tap key being decided
+static void tap_hold_release(uint16_t now) {
+    uint8_t  layer = QK_LAYER_TAP_GET_LAYER(tap_hold.keycode);
+    uint16_t tap   = QK_LAYER_TAP_GET_TAP_KEYCODE(tap_hold.keycode);
+    uint16_t held  = TIMER_DIFF_16(now, tap_hold.press_time);
+
+    switch (tap_hold.state) {
+        case TH_PENDING:
+            layer_off(layer);
+            if (held < KKB_TAP_HOLD_TERM) {
+                tap_code16(tap);
+                record_decision(KKB_TH_TAP_RELEASE, held);
+            } else {
+                record_decision(KKB_TH_HOLD_ALONE, held);
+            }
+            break;
+
+        case TH_HOLD:
+            layer_off(layer);
+            break;
+
+        case TH_TAP:
+            unregister_code16(tap);
+            break;
+    }
+
+    tap_hold.state = TH_IDLE;
+}
+
+// Another key pressed while the layer-tap key is pending
+static void tap_hold_interrupt(keyrecord_t *record) {
+    uint8_t  layer   = QK_LAYER_TAP_GET_LAYER(tap_hold.keycode);
+    uint16_t latency = TIMER_DIFF_16(record->event.time, tap_hold.press_time);
+
+    if (latency < KKB_TAP_HOLD_TERM && keymap_key_to_keycode(layer, record->event.key) == KC_NO) {
+        // Nothing to do on the layer within the term: a roll, tap before the key is processed below
+        layer_off(layer);
+        tap_code16(QK_LAYER_TAP_GET_TAP_KEYCODE(tap_hold.keycode));
+        tap_hold.state = TH_DONE;
+        record_decision(KKB_TH_TAP_ROLL, latency);
+    } else {
+        tap_hold.state = TH_HOLD;
+        record_decision(KKB_TH_HOLD_KEY, latency);
+    }
+}
+
+// Called from pre_process_record_kb(), false when the event was handled
+bool kkb_tap_hold_process(uint16_t keycode, keyrecord_t *record) {
+    if (!record->event.pressed) {
+        if (tap_hold.state != TH_IDLE && KEYEQ(record->event.key, tap_hold.key)) {
+            tap_hold_release(record->event.time);
+            return false;
+        }
+        return true;
+    }
+
+    if (tap_hold.state == TH_PENDING) {
+        tap_hold_interrupt(record);
+    }
+
+    if (IS_QK_LAYER_TAP(keycode) && tap_hold.state == TH_IDLE) {
+        tap_hold.keycode    = keycode;
+        tap_hold.key        = record->event.key;
+        tap_hold.press_time = record->event.time;
+
+        if (last_press_valid && tap_hold_flow_key(QK_LAYER_TAP_GET_TAP_KEYCODE(keycode)) && timer_elapsed32(last_press_time) < KKB_TAP_HOLD_FLOW_MS) {
+            // Fast typing: tap at once
+            register_code16(QK_LAYER_TAP_GET_TAP_KEYCODE(keycode));
+            tap_hold.state = TH_TAP;
+            record_decision(KKB_TH_TAP_FLOW, 0);
+        } else {
+            // Speculative hold, decided by the next key or the release
+            layer_on(QK_LAYER_TAP_GET_LAYER(keycode));
+            tap_hold.state = TH_PENDING;
+        }
+        return false;
+    }
+
+    // Typing speed: only keys that type count
+    if (IS_BASIC_KEYCODE(keycode)) {
+        last_press_time  = timer_read32();
+        last_press_valid = true;
+    }
+
+    return true;
+}
+
+// Copy the latency histogram of a decision
+void kkb_tap_hold_get_histogram(uint8_t decision, uint16_t buckets[KKB_TAP_HOLD_BUCKETS]) {
+    for (uint8_t bucket = 0; bucket < KKB_TAP_HOLD_BUCKETS; bucket++) {
+        buckets[bucket] = tap_hold_histogram[decision][bucket];
+    }
+}
+
+// Print the latency histograms
+void kkb_tap_hold_dump_stats(void) {
+    uprintf("TAPH BUCKETS %u %u %u %u %u\n", tap_hold_bucket_ms[0], tap_hold_bucket_ms[1], tap_hold_bucket_ms[2], tap_hold_bucket_ms[3], tap_hold_bucket_ms[4]);
+    for (uint8_t decision = 0; decision < KKB_TH_DECISIONS; decision++) {
+        const uint16_t *buckets = tap_hold_histogram[decision];
+        uprintf("TAPH %s %u %u %u %u %u %u\n", tap_hold_decision_names[decision], buckets[0], buckets[1], buckets[2], buckets[3], buckets[4], buckets[5]);
+    }
+}
+
+#endif
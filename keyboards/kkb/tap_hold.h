@@ -0,0 +1,58 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief Predictive tap-hold for LT() keys (opt-in, define KKB_TAP_HOLD_ENABLE in config.h)
+ *
+ * Takes LT() keys out of QMK's tapping term, and decides without waiting:
+ *  - During fast typing (a key was pressed less than KKB_TAP_HOLD_FLOW_MS
+ *    before): tap, on press. Not for LT(layer, KC_CAPS), which is decided
+ *    as below, so Caps Lock is not toggled by a press right after typing
+ *  - Otherwise the layer is switched on at once (speculative hold). Another
+ *    key pressed while it is held decides hold, unless that key has no
+ *    function (KC_NO) on the layer and comes within KKB_TAP_HOLD_TERM. Then
+ *    it is a roll: tap, and the key is processed on the layers below
+ *  - Released alone before KKB_TAP_HOLD_TERM: tap, on release
+ *
+ * Decision latencies are counted in a histogram, dumped with KC_DIAG.
+ * tools/keyrec_replay.py models the same decisions for recorded traces.
+ */
+
+// Time (ms) since the last key press, below which a layer-tap key taps at once
+#ifndef KKB_TAP_HOLD_FLOW_MS
+#    define KKB_TAP_HOLD_FLOW_MS 150
+#endif
+
+// Layer-tap key released alone within this time (ms) taps
+#ifndef KKB_TAP_HOLD_TERM
+#    ifdef TAPPING_TERM
+#        define KKB_TAP_HOLD_TERM TAPPING_TERM
+#    else
+#        define KKB_TAP_HOLD_TERM 200
+#    endif
+#endif
+
+#ifdef KKB_TAP_HOLD_ENABLE
+
+// Decisions, and how they were made
+enum kkb_tap_hold_decision {
+    KKB_TH_TAP_FLOW,    // Tap, fast typing (latency 0)
+    KKB_TH_TAP_ROLL,    // Tap, next key has no function on the layer
+    KKB_TH_TAP_RELEASE, // Tap, released alone within the term
+    KKB_TH_HOLD_KEY,    // Hold, next key used on the layer
+    KKB_TH_HOLD_ALONE,  // Hold, released alone after the term
+    KKB_TH_DECISIONS
+};
+
+// Latency histogram buckets: < 10, < 25, < 50, < 100, < 200, >= 200 ms
+#define KKB_TAP_HOLD_BUCKETS 6
+
+bool kkb_tap_hold_process(uint16_t keycode, keyrecord_t *record);
+void kkb_tap_hold_get_histogram(uint8_t decision, uint16_t buckets[KKB_TAP_HOLD_BUCKETS]);
+void kkb_tap_hold_dump_stats(void);
+
+#endif
@@ -0,0 +1,113 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "usb_suspend.h"
+#include "rgb_flush.h"
+#include "cycle_time.h"
+#include "print.h"
+
+uint8_t kkb_suspend_state = KKB_AWAKE;
+
+static kkb_suspend_stats_t suspend_stats;
+static volatile bool       wake_edge_seen = false; // Set from the row EXTI
+static volatile uint32_t   wake_edge_cycles;
+static bool                wake_detected = false;
+static uint32_t            resume_cycles;
+
+static inline void saturating_inc(uint16_t *counter) {
+    if (*counter < UINT16_MAX) {
+        (*counter)++;
+    }
+}
+
+// Row EXTI (ISR): keep the first edge after suspend
+void kkb_suspend_wake_edge(void) {
+    if (!wake_edge_seen) {
+        wake_edge_cycles = DWT->CYCCNT;
+        wake_edge_seen   = true;
+    }
+}
+
+// Suspended: first debounced key press. Resuming: first scan after resume
+void kkb_suspend_scan_slow(void) {
+    if (kkb_suspend_state == KKB_RESUMING) {
+        kkb_update_time(&suspend_stats.resume_scan_us_last, &suspend_stats.resume_scan_us_max, resume_cycles);
+        kkb_suspend_state = KKB_AWAKE;
+        return;
+    }
+
+    if (wake_detected) {
+        return;
+    }
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            // suspend_wakeup_condition() is true, QMK sends the remote wakeup
+            wake_detected = true;
+            saturating_inc(&suspend_stats.wakeups);
+            if (wake_edge_seen) {
+                kkb_update_time(&suspend_stats.wake_us_last, &suspend_stats.wake_us_max, wake_edge_cycles);
+            }
+            return;
+        }
+    }
+}
+
+// QMK: Suspend (called repeatedly while suspended)
+void suspend_power_down_kb(void) {
+    if (kkb_suspend_state != KKB_SUSPENDED) {
+        kkb_suspend_state = KKB_SUSPENDED;
+        wake_edge_seen    = false;
+        wake_detected     = false;
+        saturating_inc(&suspend_stats.suspends);
+
+#ifdef RGB_MATRIX_ENABLE
+        // Blank and stop rendering (QMK also does this with "sleep": true), then shut the drivers down (once set up, see rgb_flush.h)
+        rgb_matrix_set_suspend_state(true);
+        if (kkb_rgb_flush_started()) {
+            kkb_rgb_flush_lock();
+            for (uint8_t i = 0; i < SNLED27351_DRIVER_COUNT; i++) {
+                snled27351_sw_shutdown(i);
+            }
+            kkb_rgb_flush_unlock();
+        }
+#endif
+
+        matrix_suspend_kkb();
+    }
+
+    suspend_power_down_user();
+}
+
+// QMK: Resume. Matrix first, LEDs last
+void suspend_wakeup_init_kb(void) {
+    if (kkb_suspend_state == KKB_SUSPENDED) {
+        resume_cycles = DWT->CYCCNT;
+        matrix_resume_kkb();
+        kkb_suspend_state = KKB_RESUMING;
+        saturating_inc(&suspend_stats.resumes);
+
+#ifdef RGB_MATRIX_ENABLE
+        if (kkb_rgb_flush_started()) {
+            kkb_rgb_flush_lock();
+            for (uint8_t i = 0; i < SNLED27351_DRIVER_COUNT; i++) {
+                snled27351_sw_return_normal(i);
+            }
+            kkb_rgb_flush_unlock();
+        }
+        rgb_matrix_set_suspend_state(false);
+#endif
+    }
+
+    suspend_wakeup_init_user();
+}
+
+// Copy the counters
+void kkb_suspend_get_stats(kkb_suspend_stats_t *stats) {
+    *stats = suspend_stats;
+}
+
+// Print the counters
+void kkb_suspend_dump_stats(void) {
+    // suspends resumes wakeups wake_us_last wake_us_max resume_scan_us_last resume_scan_us_max
+    uprintf("SUSP %u %u %u %lu %lu %lu %lu\n", suspend_stats.suspends, suspend_stats.resumes, suspend_stats.wakeups, (unsigned long)suspend_stats.wake_us_last, (unsigned long)suspend_stats.wake_us_max, (unsigned long)suspend_stats.resume_scan_us_last, (unsigned long)suspend_stats.resume_scan_us_max);
+}
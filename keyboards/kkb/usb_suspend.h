@@ -0,0 +1,57 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief USB suspend and resume (suspend_power_down_kb / suspend_wakeup_init_kb)
+ *
+ * On suspend RGB rendering is stopped, both SNLED27351 drivers are put in
+ * software shutdown, and the matrix is switched to wake mode: all columns
+ * are driven low and the HC595 pins are parked, so any key press pulls its
+ * row low and raises a row EXTI. On resume the matrix is restored first and
+ * the LEDs last.
+ *
+ * Counters for the wake path (row edge to remote wakeup request) and the
+ * resume path (resume to first full scan) are dumped with KC_DIAG.
+ */
+
+/**
+ * @brief Suspend and resume counters, times in microseconds
+ */
+typedef struct {
+    uint16_t suspends;            // USB suspends
+    uint16_t resumes;             // Resumes (host or remote wakeup)
+    uint16_t wakeups;             // Key presses while suspended (remote wakeup, if the host allows it)
+    uint32_t wake_us_last;        // Row edge (EXTI) to debounced key press, the remote wakeup condition
+    uint32_t wake_us_max;         //
+    uint32_t resume_scan_us_last; // suspend_wakeup_init_kb() to first debounced scan
+    uint32_t resume_scan_us_max;  //
+} kkb_suspend_stats_t;
+
+// Suspend state, KKB_AWAKE in normal operation
+enum kkb_suspend_state {
+    KKB_AWAKE,
+    KKB_SUSPENDED, // Suspended, matrix in wake mode
+    KKB_RESUMING,  // Resumed, waiting for the first full scan
+};
+
+extern uint8_t kkb_suspend_state;
+
+void kkb_suspend_wake_edge(void);
+void kkb_suspend_scan_slow(void);
+void kkb_suspend_get_stats(kkb_suspend_stats_t *stats);
+void kkb_suspend_dump_stats(void);
+
+// Call after every debounced matrix scan (matrix_scan_kb)
+static inline void kkb_suspend_scan(void) {
+    if (kkb_suspend_state != KKB_AWAKE) {
+        kkb_suspend_scan_slow();
+    }
+}
+
+// Matrix wake mode (matrix.c)
+void matrix_suspend_kkb(void);
+void matrix_resume_kkb(void);
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 kkb (@ktragethon)
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Keyboard headers for the host tests.
+
+Generates from keyboards/kkb/keyboard.json what QMK generates for a build:
+  - info_config.h: matrix size and pins, diode direction, LED count
+  - default_keyboard.h: QMK_KEYBOARD_H, the keyboard header and the
+    LAYOUT_69_iso() macro (and its aliases)
+  - default_keyboard.c: g_led_config (matrix to LED, positions, flags)
+
+Usage:
+    python3 ./tests/gen_keyboard.py keyboards/kkb/keyboard.json tests/build
+"""
+
+import json
+import argparse
+from pathlib import Path
+
+HEADER = """// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// GENERATED FILE - DO NOT EDIT
+// Generated by tests/gen_keyboard.py from keyboard.json
+"""
+
+NO_LED = 'NO_LED'
+
+
+def pin_list(pins):
+    return '{ ' + ', '.join(pin if pin else 'NO_PIN' for pin in pins) + ' }'
+
+
+def info_config(info):
+    """Matrix and LED configuration, as QMK's info_config.h"""
+    rows = info['matrix_pins']['rows']
+    cols = info['matrix_pins']['cols']
+    lines = [HEADER, '#pragma once', '']
+
+    defines = [
+        ('MATRIX_ROWS', len(rows)),
+        ('MATRIX_COLS', len(cols)),
+        ('MATRIX_ROW_PINS', pin_list(rows)),
+        ('MATRIX_COL_PINS', pin_list(cols)),
+        ('DIODE_DIRECTION', info['diode_direction']),
+    ]
+    if 'dip_switch' in info:
+        defines.append(('DIP_SWITCH_PINS', pin_list(info['dip_switch']['pins'])))
+    if 'rgb_matrix' in info:
+        defines.append(('RGB_MATRIX_LED_COUNT', len(info['rgb_matrix']['layout'])))
+
+    for name, value in defines:
+        lines.append(f'#ifndef {name}')
+        lines.append(f'#    define {name} {value}')
+        lines.append('#endif')
+    return '\n'.join(lines) + '\n'
+
+
+def default_keyboard_h(info, keyboard_h):
+    """QMK_KEYBOARD_H: the keyboard header, and the LAYOUT macros (arguments in layout order, at their matrix positions)"""
+    row_count = len(info['matrix_pins']['rows'])
+    col_count = len(info['matrix_pins']['cols'])
+    lines = [HEADER, '#pragma once', '', '#include "quantum.h"']
+    if keyboard_h.is_file():
+        lines.append(f'#include "{keyboard_h.name}"')
+    lines.append('')
+
+    for name, layout in info['layouts'].items():
+        matrix = [['KC_NO'] * col_count for _ in range(row_count)]
+        args = []
+        for key in layout['layout']:
+            row, col = key['matrix']
+            arg = f'k{row:X}{col:X}'
+            matrix[row][col] = arg
+            args.append(arg)
+
+        lines.append(f'#define {name}({", ".join(args)}) {{ \\')
+        for row in matrix:
+            lines.append(f'    {{ {", ".join(row)} }}, \\')
+        lines.append('}')
+        lines.append('')
+
+    for alias, target in info.get('layout_aliases', {}).items():
+        lines.append(f'#define {alias} {target}')
+    return '\n'.join(lines) + '\n'
+
+
+def default_keyboard_c(info):
+    """g_led_config, LED index in rgb_matrix.layout order"""
+    row_count = len(info['matrix_pins']['rows'])
+    col_count = len(info['matrix_pins']['cols'])
+    leds = info['rgb_matrix']['layout']
+
+    matrix = [[NO_LED] * col_count for _ in range(row_count)]
+    for index, led in enumerate(leds):
+        if 'matrix' in led:
+            row, col = led['matrix']
+            matrix[row][col] = str(index)
+
+    lines = [HEADER, '#include "quantum.h"', '', '#ifdef RGB_MATRIX_ENABLE',
+             '__attribute__((weak)) led_config_t g_led_config = {', '    {']
+    for row in matrix:
+        lines.append(f'        {{ {", ".join(row)} }},')
+    lines.append('    },')
+    lines.append('    { ' + ', '.join(f'{{{led["x"]}, {led["y"]}}}' for led in leds) + ' },')
+    lines.append('    { ' + ', '.join(str(led['flags']) for led in leds) + ' },')
+    lines.append('};')
+    lines.append('#endif')
+    return '\n'.join(lines) + '\n'
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Generate the QMK keyboard headers for the host tests")
+    parser.add_argument('keyboard_json', type=Path, help="Path to keyboard.json")
+    parser.add_argument('output', type=Path, help="Output directory")
+    args = parser.parse_args(argv)
+
+    info = json.loads(args.keyboard_json.read_text(encoding='utf-8'))
+    args.output.mkdir(parents=True, exist_ok=True)
+
+    (args.output / 'info_config.h').write_text(info_config(info), encoding='utf-8')
+    (args.output / 'default_keyboard.h').write_text(default_keyboard_h(info, args.keyboard_json.parent / f'{args.keyboard_json.parent.name}.h'), encoding='utf-8')
+    (args.output / 'default_keyboard.c').write_text(default_keyboard_c(info), encoding='utf-8')
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,77 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "host_stubs.h"
+#include "hc595_matrix.h"
+
+/**
+ * @brief Model of the HC595 shift register chain on the stub pins (host tests only)
+ *
+ * Replaces the pin writes of qmk_stubs.c, so include it from one file of a
+ * test. Output n of the chain is bit n (Q0-Q7 of the first register, then
+ * the next). A rising shift clock moves every bit one output up and takes DS
+ * into Q0, a rising storage clock latches the shift register to the outputs.
+ */
+
+static uint32_t chain_shift;
+static uint32_t chain_outputs;
+static uint32_t chain_shift_edges;
+static uint32_t chain_latch_edges;
+static bool     chain_outputs_changed_early;
+
+void gpio_write_pin_high(pin_t pin) {
+    bool rising         = !host_pin_level[pin];
+    host_pin_level[pin] = true;
+    if (!rising || !host_pin_output[pin]) {
+        return;
+    }
+
+    if (pin == HC595_SHCP_PIN) {
+        chain_shift = (chain_shift << 1) | host_pin_level[HC595_DS_PIN];
+        chain_shift_edges++;
+    } else if (pin == HC595_STCP_PIN) {
+        // Latched before all bits are shifted in: outputs glitch
+        chain_outputs_changed_early |= chain_shift_edges % HC595_BITS != 0;
+        chain_outputs = chain_shift & (uint32_t)(hc595_data_t)~(hc595_data_t)0;
+        chain_latch_edges++;
+    }
+}
+
+void gpio_write_pin_low(pin_t pin) {
+    host_pin_level[pin] = false;
+}
+
+// Power-on state: outputs undefined until the first latch
+static void chain_reset(void) {
+    chain_shift                 = 0;
+    chain_outputs               = 0x5A5A5A5A;
+    chain_shift_edges           = 0;
+    chain_latch_edges           = 0;
+    chain_outputs_changed_early = false;
+}
+
+// Chain output wired to a shift-register column
+static uint8_t chain_column_output(uint8_t col) {
+    uint8_t bit = col - HC595_GPIO_COLS + HC595_BIT_OFFSET;
+#ifdef HC595_LSB_FIRST
+    // The lowest bit is shifted first and ends up at the far end of the chain
+    return HC595_BITS - 1 - bit;
+#else
+    return bit;
+#endif
+}
+
+// Output level of a selected column
+#ifdef HC595_ACTIVE_HIGH
+#    define CHAIN_SELECTED 1
+#else
+#    define CHAIN_SELECTED 0
+#endif
+
+// Outputs at the selected level, as a bit mask
+static uint32_t chain_selected_outputs(void) {
+    uint32_t all = (uint32_t)(hc595_data_t)~(hc595_data_t)0;
+    return CHAIN_SELECTED ? chain_outputs : ~chain_outputs & all;
+}
@@ -0,0 +1,28 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief State of the QMK stand-ins in qmk_stubs.c, set and read by the tests
+ */
+
+// Pins: level (true = high) and direction
+extern bool host_pin_level[HOST_PIN_COUNT];
+extern bool host_pin_output[HOST_PIN_COUNT];
+
+// Host keyboard LEDs (Caps Lock, ...) and the user eeconfig word
+extern led_t    host_led_state;
+extern uint32_t host_eeconfig_user;
+
+#ifdef RGB_MATRIX_ENABLE
+// LED colors set with rgb_matrix_set_color(), and the number of calls
+extern rgb_t    host_leds[RGB_MATRIX_LED_COUNT];
+extern uint32_t host_led_calls;
+#endif
+
+// Dense keymap lookup (keymap_introspection.c), for the tests' expected values
+uint16_t keycode_at_keymap_location_raw(uint8_t layer_num, uint8_t row, uint8_t column);
+uint8_t  keymap_layer_count_raw(void);
@@ -0,0 +1,141 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * @brief QMK keycodes used by the kkb keymaps (host tests only)
+ *
+ * Same values as QMK's quantum/keycodes.h and quantum_keycodes.h, so
+ * encoded keycodes (LT(), MO(), modifier wrappers) decode as in the
+ * firmware.
+ */
+
+// clang-format off
+enum qk_keycode_defines {
+    KC_NO   = 0x0000,
+    KC_TRNS = 0x0001,
+
+    // Basic keycodes (HID usages)
+    KC_A = 0x0004, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M,
+    KC_N, KC_O, KC_P, KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W, KC_X, KC_Y, KC_Z,
+    KC_1 = 0x001E, KC_2, KC_3, KC_4, KC_5, KC_6, KC_7, KC_8, KC_9, KC_0,
+    KC_ENTER = 0x0028, KC_ESCAPE, KC_BACKSPACE, KC_TAB, KC_SPACE, KC_MINUS, KC_EQUAL,
+    KC_LEFT_BRACKET, KC_RIGHT_BRACKET, KC_BACKSLASH, KC_NONUS_HASH, KC_SEMICOLON, KC_QUOTE,
+    KC_GRAVE, KC_COMMA, KC_DOT, KC_SLASH, KC_CAPS_LOCK,
+    KC_F1 = 0x003A, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7, KC_F8, KC_F9, KC_F10, KC_F11, KC_F12,
+    KC_PRINT_SCREEN = 0x0046, KC_SCROLL_LOCK, KC_PAUSE, KC_INSERT, KC_HOME, KC_PAGE_UP,
+    KC_DELETE, KC_END, KC_PAGE_DOWN, KC_RIGHT, KC_LEFT, KC_DOWN, KC_UP,
+    KC_NONUS_BACKSLASH = 0x0064,
+    KC_F13 = 0x0068,
+    KC_EXSEL = 0x00A4,
+
+    // Consumer / system (QMK's internal values)
+    KC_AUDIO_MUTE = 0x00A8, KC_AUDIO_VOL_UP, KC_AUDIO_VOL_DOWN, KC_MEDIA_NEXT_TRACK,
+    KC_MEDIA_PREV_TRACK, KC_MEDIA_STOP, KC_MEDIA_PLAY_PAUSE,
+    KC_BRIGHTNESS_UP = 0x00BA, KC_BRIGHTNESS_DOWN,
+
+    // Modifiers
+    KC_LEFT_CTRL = 0x00E0, KC_LEFT_SHIFT, KC_LEFT_ALT, KC_LEFT_GUI,
+    KC_RIGHT_CTRL, KC_RIGHT_SHIFT, KC_RIGHT_ALT, KC_RIGHT_GUI,
+
+    // Ranges
+    QK_MODS            = 0x0100,
+    QK_LAYER_TAP       = 0x4000,
+    QK_LAYER_TAP_MAX   = 0x4FFF,
+    QK_TO              = 0x5200,
+    QK_MOMENTARY       = 0x5220,
+    QK_DEF_LAYER       = 0x5240,
+    QK_TOGGLE_LAYER    = 0x5260,
+
+    NK_TOGG = 0x7013,
+
+    // RGB matrix
+    RM_ON = 0x7840, RM_OFF, RM_TOGG, RM_NEXT, RM_PREV, RM_HUEU, RM_HUED, RM_SATU, RM_SATD,
+    RM_VALU, RM_VALD, RM_SPDU, RM_SPDD,
+
+    QK_BOOT   = 0x7C00,
+    QK_USER_0 = 0x7E40,
+};
+// clang-format on
+
+// Short names
+#define KC_ENT KC_ENTER
+#define KC_ESC KC_ESCAPE
+#define KC_BSPC KC_BACKSPACE
+#define KC_SPC KC_SPACE
+#define KC_MINS KC_MINUS
+#define KC_EQL KC_EQUAL
+#define KC_LBRC KC_LEFT_BRACKET
+#define KC_RBRC KC_RIGHT_BRACKET
+#define KC_BSLS KC_BACKSLASH
+#define KC_NUHS KC_NONUS_HASH
+#define KC_SCLN KC_SEMICOLON
+#define KC_QUOT KC_QUOTE
+#define KC_GRV KC_GRAVE
+#define KC_COMM KC_COMMA
+#define KC_SLSH KC_SLASH
+#define KC_CAPS KC_CAPS_LOCK
+#define KC_PSCR KC_PRINT_SCREEN
+#define KC_INS KC_INSERT
+#define KC_PGUP KC_PAGE_UP
+#define KC_DEL KC_DELETE
+#define KC_PGDN KC_PAGE_DOWN
+#define KC_RGHT KC_RIGHT
+#define KC_NUBS KC_NONUS_BACKSLASH
+#define KC_MUTE KC_AUDIO_MUTE
+#define KC_VOLU KC_AUDIO_VOL_UP
+#define KC_VOLD KC_AUDIO_VOL_DOWN
+#define KC_MNXT KC_MEDIA_NEXT_TRACK
+#define KC_MPRV KC_MEDIA_PREV_TRACK
+#define KC_MSTP KC_MEDIA_STOP
+#define KC_MPLY KC_MEDIA_PLAY_PAUSE
+#define KC_BRIU KC_BRIGHTNESS_UP
+#define KC_BRID KC_BRIGHTNESS_DOWN
+#define KC_LCTL KC_LEFT_CTRL
+#define KC_LSFT KC_LEFT_SHIFT
+#define KC_LALT KC_LEFT_ALT
+#define KC_LGUI KC_LEFT_GUI
+#define KC_LWIN KC_LEFT_GUI
+#define KC_RCTL KC_RIGHT_CTRL
+#define KC_RSFT KC_RIGHT_SHIFT
+#define KC_RALT KC_RIGHT_ALT
+#define KC_RGUI KC_RIGHT_GUI
+#define XXXXXXX KC_NO
+#define _______ KC_TRNS
+
+// Modifier wrappers
+#define LCTL(kc) (QK_MODS | 0x0100 | (kc))
+#define LSFT(kc) (QK_MODS | 0x0200 | (kc))
+#define LALT(kc) (QK_MODS | 0x0400 | (kc))
+#define LGUI(kc) (QK_MODS | 0x0800 | (kc))
+#define RCTL(kc) (QK_MODS | 0x1100 | (kc))
+#define RSFT(kc) (QK_MODS | 0x1200 | (kc))
+#define RALT(kc) (QK_MODS | 0x1400 | (kc))
+#define RGUI(kc) (QK_MODS | 0x1800 | (kc))
+#define C(kc) LCTL(kc)
+#define S(kc) LSFT(kc)
+#define A(kc) LALT(kc)
+#define G(kc) LGUI(kc)
+#define ALGR(kc) RALT(kc)
+#define KC_TILD S(KC_GRV)
+
+// Layers
+#define LT(layer, kc) (QK_LAYER_TAP | (((layer) & 0xF) << 8) | ((kc) & 0xFF))
+#define TO(layer) (QK_TO | ((layer) & 0x1F))
+#define MO(layer) (QK_MOMENTARY | ((layer) & 0x1F))
+#define DF(layer) (QK_DEF_LAYER | ((layer) & 0x1F))
+#define TG(layer) (QK_TOGGLE_LAYER | ((layer) & 0x1F))
+
+#define IS_QK_LAYER_TAP(code) ((code) >= QK_LAYER_TAP && (code) <= QK_LAYER_TAP_MAX)
+#define QK_LAYER_TAP_GET_LAYER(kc) (((kc) >> 8) & 0xF)
+#define QK_LAYER_TAP_GET_TAP_KEYCODE(kc) ((kc) & 0xFF)
+#define IS_QK_MOMENTARY(code) ((code) >= QK_MOMENTARY && (code) <= QK_MOMENTARY + 0x1F)
+#define IS_QK_TO(code) ((code) >= QK_TO && (code) <= QK_TO + 0x1F)
+#define IS_QK_TOGGLE_LAYER(code) ((code) >= QK_TOGGLE_LAYER && (code) <= QK_TOGGLE_LAYER + 0x1F)
+#define QK_LAYER_GET(kc) ((kc) & 0x1F)
+
+#define IS_BASIC_KEYCODE(code) ((code) >= KC_A && (code) <= KC_EXSEL)
+#define IS_MODIFIER_KEYCODE(code) ((code) >= KC_LEFT_CTRL && (code) <= KC_RIGHT_GUI)
+
+#define MOD_BIT(code) (1 << ((code) & 0x07))
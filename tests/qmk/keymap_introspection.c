@@ -0,0 +1,30 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Keymap introspection as QMK's quantum/keymap_introspection.c (host tests only):
+// keymap.c is compiled here, next to the weak default lookup in keymaps[]
+
+#include "quantum.h"
+
+#include KEYMAP_C
+
+#define NUM_KEYMAP_LAYERS_RAW ((uint8_t)(sizeof(keymaps) / ((MATRIX_ROWS) * (MATRIX_COLS) * sizeof(uint16_t))))
+
+uint8_t keymap_layer_count_raw(void) {
+    return NUM_KEYMAP_LAYERS_RAW;
+}
+
+__attribute__((weak)) uint8_t keymap_layer_count(void) {
+    return keymap_layer_count_raw();
+}
+
+uint16_t keycode_at_keymap_location_raw(uint8_t layer_num, uint8_t row, uint8_t column) {
+    if (layer_num < NUM_KEYMAP_LAYERS_RAW && row < MATRIX_ROWS && column < MATRIX_COLS) {
+        return pgm_read_word(&keymaps[layer_num][row][column]);
+    }
+    return KC_TRNS;
+}
+
+__attribute__((weak)) uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    return keycode_at_keymap_location_raw(layer_num, row, column);
+}
@@ -0,0 +1,29 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Norwegian keycodes used by the kkb keymaps (host tests only), as QMK's keymap_extras/keymap_norwegian.h
+
+#include "keycodes.h"
+
+#define NO_PIPE KC_GRV
+#define NO_PLUS KC_MINS
+#define NO_QUOT KC_NUHS
+#define NO_LABK KC_NUBS
+#define NO_MINS KC_SLSH
+#define NO_DQUO S(KC_2)
+#define NO_AMPR S(KC_6)
+#define NO_SLSH S(KC_7)
+#define NO_LPRN S(KC_8)
+#define NO_RPRN S(KC_9)
+#define NO_EQL S(KC_0)
+#define NO_QUES S(NO_PLUS)
+#define NO_ASTR S(NO_QUOT)
+#define NO_RABK S(NO_LABK)
+#define NO_SCLN S(KC_COMM)
+#define NO_COLN S(KC_DOT)
+#define NO_LCBR ALGR(KC_7)
+#define NO_LBRC ALGR(KC_8)
+#define NO_RBRC ALGR(KC_9)
+#define NO_RCBR ALGR(KC_0)
@@ -0,0 +1,12 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// QMK console output, to stdout (host tests only)
+
+int host_printf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+#define uprintf(...) host_printf(__VA_ARGS__)
+#define xprintf(...) host_printf(__VA_ARGS__)
+#define dprintf(...) host_printf(__VA_ARGS__)
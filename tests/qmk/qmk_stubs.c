@@ -0,0 +1,376 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// QMK functions used by the kkb modules (host tests only). All weak, a test
+// replaces the ones it models itself (pins of a matrix, reports, ...)
+
+#include <stdio.h>
+#include <stdarg.h>
+
+#include "host_stubs.h"
+#ifdef SEND_STRING_ENABLE
+#    include "send_string.h"
+#endif
+
+#define HOST_WEAK __attribute__((weak))
+
+// ============================== PINS ========================================
+
+bool host_pin_level[HOST_PIN_COUNT];
+bool host_pin_output[HOST_PIN_COUNT];
+
+HOST_WEAK void gpio_set_pin_output(pin_t pin) {
+    host_pin_output[pin] = true;
+}
+
+HOST_WEAK void gpio_set_pin_input_high(pin_t pin) {
+    host_pin_output[pin] = false;
+    host_pin_level[pin]  = true; // Pull-up
+}
+
+HOST_WEAK void gpio_write_pin_high(pin_t pin) {
+    host_pin_level[pin] = true;
+}
+
+HOST_WEAK void gpio_write_pin_low(pin_t pin) {
+    host_pin_level[pin] = false;
+}
+
+HOST_WEAK uint8_t gpio_read_pin(pin_t pin) {
+    return host_pin_level[pin];
+}
+
+HOST_WEAK void palEnableLineEvent(pin_t pin, uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+HOST_WEAK void palDisableLineEvent(pin_t pin) {
+    (void)pin;
+}
+
+HOST_WEAK void palSetLineCallback(pin_t pin, palcallback_t callback, void *arg) {
+    (void)pin;
+    (void)callback;
+    (void)arg;
+}
+
+// ============================== TIME ========================================
+
+uint32_t          host_timer_ms = 0;
+host_core_debug_t host_core_debug;
+host_dwt_t        host_dwt;
+
+HOST_WEAK uint16_t timer_read(void) {
+    return (uint16_t)host_timer_ms;
+}
+
+HOST_WEAK uint32_t timer_read32(void) {
+    return host_timer_ms;
+}
+
+HOST_WEAK uint16_t timer_elapsed(uint16_t last) {
+    return TIMER_DIFF_16(timer_read(), last);
+}
+
+HOST_WEAK uint32_t timer_elapsed32(uint32_t last) {
+    return TIMER_DIFF_32(timer_read32(), last);
+}
+
+HOST_WEAK void wait_ms(uint32_t ms) {
+    host_timer_ms += ms;
+}
+
+HOST_WEAK void wait_us(uint32_t us) {
+    (void)us;
+}
+
+// ============================== MATRIX ======================================
+
+HOST_WEAK matrix_row_t matrix_get_row(uint8_t row) {
+    (void)row;
+    return 0;
+}
+
+// ============================== LAYERS ======================================
+
+layer_state_t layer_state         = 0;
+layer_state_t default_layer_state = 0;
+
+HOST_WEAK uint8_t get_highest_layer(layer_state_t state) {
+    return state ? 31 - __builtin_clz(state) : 0;
+}
+
+HOST_WEAK void layer_on(uint8_t layer) {
+    layer_state |= (layer_state_t)1 << layer;
+}
+
+HOST_WEAK void layer_off(uint8_t layer) {
+    layer_state &= ~((layer_state_t)1 << layer);
+}
+
+HOST_WEAK void layer_move(uint8_t layer) {
+    layer_state = (layer_state_t)1 << layer;
+}
+
+HOST_WEAK void layer_invert(uint8_t layer) {
+    layer_state ^= (layer_state_t)1 << layer;
+}
+
+HOST_WEAK void default_layer_set(layer_state_t state) {
+    default_layer_state = state;
+}
+
+// As QMK's keymap_common.c. Tests without a keymap do not link keymap_introspection.c
+#pragma weak keycode_at_keymap_location
+HOST_WEAK uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    return keycode_at_keymap_location ? keycode_at_keymap_location(layer, key.row, key.col) : KC_NO;
+}
+
+// As QMK's action_layer.c: highest active layer where the key is not transparent
+HOST_WEAK uint8_t layer_switch_get_layer(keypos_t key) {
+    layer_state_t layers = layer_state | default_layer_state;
+    for (int8_t layer = 31; layer >= 0; layer--) {
+        if ((layers & ((layer_state_t)1 << layer)) && keymap_key_to_keycode(layer, key) != KC_TRNS) {
+            return layer;
+        }
+    }
+    return 0;
+}
+
+// ============================== KEYS ========================================
+
+led_t    host_led_state     = {0};
+uint32_t host_eeconfig_user = 0;
+
+HOST_WEAK void register_code(uint8_t kc) {
+    (void)kc;
+}
+
+HOST_WEAK void unregister_code(uint8_t kc) {
+    (void)kc;
+}
+
+HOST_WEAK void tap_code(uint8_t kc) {
+    register_code(kc);
+    unregister_code(kc);
+}
+
+HOST_WEAK void register_code16(uint16_t kc) {
+    register_code((uint8_t)kc);
+}
+
+HOST_WEAK void unregister_code16(uint16_t kc) {
+    unregister_code((uint8_t)kc);
+}
+
+HOST_WEAK void tap_code16(uint16_t kc) {
+    register_code16(kc);
+    unregister_code16(kc);
+}
+
+HOST_WEAK void add_key(uint8_t key) {
+    (void)key;
+}
+
+HOST_WEAK void del_key(uint8_t key) {
+    (void)key;
+}
+
+HOST_WEAK void add_mods(uint8_t mods) {
+    (void)mods;
+}
+
+HOST_WEAK void del_mods(uint8_t mods) {
+    (void)mods;
+}
+
+HOST_WEAK void set_weak_mods(uint8_t mods) {
+    (void)mods;
+}
+
+HOST_WEAK void send_keyboard_report(void) {}
+
+HOST_WEAK bool host_can_send_nkro(void) {
+    return true;
+}
+
+HOST_WEAK led_t host_keyboard_led_state(void) {
+    return host_led_state;
+}
+
+HOST_WEAK uint32_t eeconfig_read_user(void) {
+    return host_eeconfig_user;
+}
+
+HOST_WEAK void eeconfig_update_user(uint32_t val) {
+    host_eeconfig_user = val;
+}
+
+#ifdef SEND_STRING_ENABLE
+// ============================== SEND STRING =================================
+
+// As QMK's send_string.c: US layout
+// clang-format off
+HOST_WEAK const uint8_t ascii_to_shift_lut[16] = {
+    KCLUT_ENTRY(0, 0, 0, 0, 0, 0, 0, 0),
+    KCLUT_ENTRY(0, 0, 0, 0, 0, 0, 0, 0),
+    KCLUT_ENTRY(0, 0, 0, 0, 0, 0, 0, 0),
+    KCLUT_ENTRY(0, 0, 0, 0, 0, 0, 0, 0),
+    KCLUT_ENTRY(0, 1, 1, 1, 1, 1, 1, 0),
+    KCLUT_ENTRY(1, 1, 1, 1, 0, 0, 0, 0),
+    KCLUT_ENTRY(0, 0, 0, 0, 0, 0, 0, 0),
+    KCLUT_ENTRY(0, 0, 1, 0, 1, 0, 1, 1),
+    KCLUT_ENTRY(1, 1, 1, 1, 1, 1, 1, 1),
+    KCLUT_ENTRY(1, 1, 1, 1, 1, 1, 1, 1),
+    KCLUT_ENTRY(1, 1, 1, 1, 1, 1, 1, 1),
+    KCLUT_ENTRY(1, 1, 1, 0, 0, 0, 1, 1),
+    KCLUT_ENTRY(0, 0, 0, 0, 0, 0, 0, 0),
+    KCLUT_ENTRY(0, 0, 0, 0, 0, 0, 0, 0),
+    KCLUT_ENTRY(0, 0, 0, 0, 0, 0, 0, 0),
+    KCLUT_ENTRY(0, 0, 0, 1, 1, 1, 1, 0),
+};
+
+HOST_WEAK const uint8_t ascii_to_altgr_lut[16] = {0};
+HOST_WEAK const uint8_t ascii_to_dead_lut[16]  = {0};
+
+HOST_WEAK const uint8_t ascii_to_keycode_lut[128] = {
+    // NUL   SOH      STX      ETX      EOT      ENQ      ACK      BEL
+    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+    // BS    TAB      LF       VT       FF       CR       SO       SI
+    KC_BSPC, KC_TAB,  KC_ENT,  XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+    // DLE   DC1      DC2      DC3      DC4      NAK      SYN      ETB
+    XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+    // CAN   EM       SUB      ESC      FS       GS       RS       US
+    XXXXXXX, XXXXXXX, XXXXXXX, KC_ESC,  XXXXXXX, XXXXXXX, XXXXXXX, XXXXXXX,
+
+    //       !        "        #        $        %        &        '
+    KC_SPC,  KC_1,    KC_QUOT, KC_3,    KC_4,    KC_5,    KC_7,    KC_QUOT,
+    // (     )        *        +        ,        -        .        /
+    KC_9,    KC_0,    KC_8,    KC_EQL,  KC_COMM, KC_MINS, KC_DOT,  KC_SLSH,
+    // 0     1        2        3        4        5        6        7
+    KC_0,    KC_1,    KC_2,    KC_3,    KC_4,    KC_5,    KC_6,    KC_7,
+    // 8     9        :        ;        <        =        >        ?
+    KC_8,    KC_9,    KC_SCLN, KC_SCLN, KC_COMM, KC_EQL,  KC_DOT,  KC_SLSH,
+    // @     A        B        C        D        E        F        G
+    KC_2,    KC_A,    KC_B,    KC_C,    KC_D,    KC_E,    KC_F,    KC_G,
+    // H     I        J        K        L        M        N        O
+    KC_H,    KC_I,    KC_J,    KC_K,    KC_L,    KC_M,    KC_N,    KC_O,
+    // P     Q        R        S        T        U        V        W
+    KC_P,    KC_Q,    KC_R,    KC_S,    KC_T,    KC_U,    KC_V,    KC_W,
+    // X     Y        Z        [        \        ]        ^        _
+    KC_X,    KC_Y,    KC_Z,    KC_LBRC, KC_BSLS, KC_RBRC, KC_6,    KC_MINS,
+    // `     a        b        c        d        e        f        g
+    KC_GRV,  KC_A,    KC_B,    KC_C,    KC_D,    KC_E,    KC_F,    KC_G,
+    // h     i        j        k        l        m        n        o
+    KC_H,    KC_I,    KC_J,    KC_K,    KC_L,    KC_M,    KC_N,    KC_O,
+    // p     q        r        s        t        u        v        w
+    KC_P,    KC_Q,    KC_R,    KC_S,    KC_T,    KC_U,    KC_V,    KC_W,
+    // x     y        z        {        |        }        ~        DEL
+    KC_X,    KC_Y,    KC_Z,    KC_LBRC, KC_BSLS, KC_RBRC, KC_GRV,  KC_DEL
+};
+// clang-format on
+
+HOST_WEAK void send_char(char ascii) {
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii);
+
+    if (is_shifted) {
+        register_code(KC_LEFT_SHIFT);
+    }
+    if (is_altgred) {
+        register_code(KC_RIGHT_ALT);
+    }
+    tap_code(keycode);
+    if (is_altgred) {
+        unregister_code(KC_RIGHT_ALT);
+    }
+    if (is_shifted) {
+        unregister_code(KC_LEFT_SHIFT);
+    }
+    if (is_dead) {
+        tap_code(KC_SPACE);
+    }
+}
+
+HOST_WEAK void send_string(const char *string) {
+    while (*string) {
+        send_char(*string++);
+    }
+}
+#endif
+
+// ============================== RGB MATRIX ==================================
+
+// As QMK's color.c (without the CIE1931 curve)
+HOST_WEAK rgb_t hsv_to_rgb(hsv_t hsv) {
+    rgb_t rgb;
+
+    if (hsv.s == 0) {
+        rgb.r = rgb.g = rgb.b = hsv.v;
+        return rgb;
+    }
+
+    uint16_t h = hsv.h, s = hsv.s, v = hsv.v;
+    uint8_t  region    = h * 6 / 255;
+    uint8_t  remainder = (h * 2 - region * 85) * 3;
+    uint8_t  p         = (v * (255 - s)) >> 8;
+    uint8_t  q         = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    uint8_t  t         = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+    switch (region) {
+        case 6:
+        case 0:
+            rgb = (rgb_t){v, t, p};
+            break;
+        case 1:
+            rgb = (rgb_t){q, v, p};
+            break;
+        case 2:
+            rgb = (rgb_t){p, v, t};
+            break;
+        case 3:
+            rgb = (rgb_t){p, q, v};
+            break;
+        case 4:
+            rgb = (rgb_t){t, p, v};
+            break;
+        default:
+            rgb = (rgb_t){v, p, q};
+            break;
+    }
+    return rgb;
+}
+
+#ifdef RGB_MATRIX_ENABLE
+rgb_t    host_leds[RGB_MATRIX_LED_COUNT];
+uint32_t host_led_calls = 0;
+
+// QMK defaults: RGB_MATRIX_DEFAULT_HUE / SAT / VAL / SPD
+rgb_config_t rgb_matrix_config = {.hsv = {0, 255, 255}, .speed = 128, .flags = LED_FLAG_ALL};
+
+HOST_WEAK void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    host_led_calls++;
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        host_leds[index] = (rgb_t){red, green, blue};
+    }
+}
+
+HOST_WEAK void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (int index = 0; index < RGB_MATRIX_LED_COUNT; index++) {
+        rgb_matrix_set_color(index, red, green, blue);
+    }
+}
+#endif
+
+// ============================== CONSOLE =====================================
+
+HOST_WEAK int host_printf(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = vprintf(format, args);
+    va_end(args);
+    return length;
+}
@@ -0,0 +1,315 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * @brief Host stand-in for QMK's quantum.h (host tests only)
+ *
+ * The part of QMK used by the kkb modules under test, with QMK's types and
+ * values. The functions are in qmk_stubs.c, weak, so a test can replace
+ * any of them (pins, host LED state, reports, ...).
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "keycodes.h"
+
+#define PACKED __attribute__((packed))
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+#define pgm_read_dword(address) (*(const uint32_t *)(address))
+#define memcpy_P memcpy
+
+#ifndef MIN
+#    define MIN(x, y) (((x) < (y)) ? (x) : (y))
+#endif
+#ifndef MAX
+#    define MAX(x, y) (((x) > (y)) ? (x) : (y))
+#endif
+
+// ============================== PINS ========================================
+
+typedef uint32_t pin_t;
+
+// Pin numbers: port * 16 + pin, A0 is 0
+// clang-format off
+enum host_pins {
+    A0, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15,
+    B0, B1, B2, B3, B4, B5, B6, B7, B8, B9, B10, B11, B12, B13, B14, B15,
+    C0, C1, C2, C3, C4, C5, C6, C7, C8, C9, C10, C11, C12, C13, C14, C15,
+    HOST_PIN_COUNT
+};
+// clang-format on
+
+#define NO_PIN ((pin_t)~0)
+
+void    gpio_set_pin_output(pin_t pin);
+void    gpio_set_pin_input_high(pin_t pin);
+void    gpio_write_pin_high(pin_t pin);
+void    gpio_write_pin_low(pin_t pin);
+uint8_t gpio_read_pin(pin_t pin);
+
+#define setPinOutput gpio_set_pin_output
+#define setPinInputHigh gpio_set_pin_input_high
+#define writePinHigh gpio_write_pin_high
+#define writePinLow gpio_write_pin_low
+#define readPin gpio_read_pin
+
+#define ATOMIC_BLOCK_FORCEON for (int atomic_once = 1; atomic_once; atomic_once = 0)
+
+// ChibiOS line events (matrix.c wake mode)
+typedef void (*palcallback_t)(void *arg);
+#define PAL_EVENT_MODE_FALLING_EDGE 2
+void palEnableLineEvent(pin_t pin, uint8_t mode);
+void palDisableLineEvent(pin_t pin);
+void palSetLineCallback(pin_t pin, palcallback_t callback, void *arg);
+
+// ============================== TIME ========================================
+
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+uint16_t timer_elapsed(uint16_t last);
+uint32_t timer_elapsed32(uint32_t last);
+void     wait_ms(uint32_t ms);
+void     wait_us(uint32_t us);
+
+#define TIMER_DIFF_16(a, b) ((uint16_t)((a) - (b)))
+#define TIMER_DIFF_32(a, b) ((uint32_t)((a) - (b)))
+
+// Host time, advanced by the tests
+extern uint32_t host_timer_ms;
+
+// Cortex-M4 cycle counter (reads 0 on the host)
+typedef struct {
+    uint32_t DEMCR;
+} host_core_debug_t;
+typedef struct {
+    uint32_t CTRL;
+    uint32_t CYCCNT;
+} host_dwt_t;
+extern host_core_debug_t host_core_debug;
+extern host_dwt_t        host_dwt;
+#define CoreDebug (&host_core_debug)
+#define DWT (&host_dwt)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk 1UL
+#define STM32_SYSCLK 80000000U
+
+// ============================== MATRIX ======================================
+
+#if MATRIX_COLS <= 8
+typedef uint8_t matrix_row_t;
+#elif MATRIX_COLS <= 16
+typedef uint16_t matrix_row_t;
+#else
+typedef uint32_t matrix_row_t;
+#endif
+#define MATRIX_ROW_SHIFTER ((matrix_row_t)1)
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+typedef struct {
+    keypos_t key;
+    uint16_t time;
+    uint8_t  type;
+    bool     pressed;
+} keyevent_t;
+
+typedef struct {
+    keyevent_t event;
+} keyrecord_t;
+
+#define KEYEQ(keya, keyb) ((keya).row == (keyb).row && (keya).col == (keyb).col)
+
+matrix_row_t matrix_get_row(uint8_t row);
+
+// ============================== LAYERS ======================================
+
+typedef uint32_t layer_state_t;
+
+extern layer_state_t layer_state;
+extern layer_state_t default_layer_state;
+
+uint8_t  get_highest_layer(layer_state_t state);
+void     layer_on(uint8_t layer);
+void     layer_off(uint8_t layer);
+void     layer_move(uint8_t layer);
+void     layer_invert(uint8_t layer);
+void     default_layer_set(layer_state_t state);
+uint8_t  layer_switch_get_layer(keypos_t key);
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
+uint8_t  keymap_layer_count(void);
+uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column);
+
+// ============================== KEYS ========================================
+
+void register_code(uint8_t kc);
+void unregister_code(uint8_t kc);
+void tap_code(uint8_t kc);
+void register_code16(uint16_t kc);
+void unregister_code16(uint16_t kc);
+void tap_code16(uint16_t kc);
+
+void add_key(uint8_t key);
+void del_key(uint8_t key);
+void add_mods(uint8_t mods);
+void del_mods(uint8_t mods);
+void set_weak_mods(uint8_t mods);
+void send_keyboard_report(void);
+bool host_can_send_nkro(void);
+
+typedef union {
+    uint8_t raw;
+    struct {
+        bool    num_lock : 1;
+        bool    caps_lock : 1;
+        bool    scroll_lock : 1;
+        bool    compose : 1;
+        bool    kana : 1;
+        uint8_t reserved : 3;
+    };
+} led_t;
+
+led_t host_keyboard_led_state(void);
+
+uint32_t eeconfig_read_user(void);
+void     eeconfig_update_user(uint32_t val);
+
+// ============================== RGB MATRIX ==================================
+
+typedef struct PACKED {
+    uint8_t h;
+    uint8_t s;
+    uint8_t v;
+} hsv_t;
+
+typedef struct PACKED {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} rgb_t;
+
+#define HSV_WHITE 0, 0, 255
+#define HSV_ORANGE 21, 255, 255
+#define HSV_GOLDENROD 30, 218, 218
+#define HSV_GREEN 85, 255, 255
+#define HSV_SPRINGGREEN 106, 255, 255
+#define HSV_CYAN 128, 255, 255
+#define HSV_BLUE 170, 255, 255
+#define RGB_OFF 0, 0, 0
+
+rgb_t hsv_to_rgb(hsv_t hsv);
+
+#ifdef RGB_MATRIX_ENABLE
+#    define NO_LED 255
+#    define LED_FLAG_NONE 0x00
+#    define LED_FLAG_MODIFIER 0x01
+#    define LED_FLAG_UNDERGLOW 0x02
+#    define LED_FLAG_KEYLIGHT 0x04
+#    define LED_FLAG_INDICATOR 0x08
+
+typedef struct PACKED {
+    uint8_t x;
+    uint8_t y;
+} led_point_t;
+
+typedef struct PACKED {
+    uint8_t     matrix_co[MATRIX_ROWS][MATRIX_COLS];
+    led_point_t point[RGB_MATRIX_LED_COUNT];
+    uint8_t     flags[RGB_MATRIX_LED_COUNT];
+} led_config_t;
+
+extern led_config_t g_led_config;
+
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
+void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+
+// Effects: as QMK's rgb_matrix.h / rgb_matrix_types.h
+#    define LED_FLAG_ALL 0xFF
+#    define HAS_ANY_FLAGS(bits, flags) (((bits) & (flags)) != 0)
+
+#    ifndef RGB_MATRIX_LED_PROCESS_LIMIT
+#        define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
+#    endif
+
+typedef uint8_t led_flags_t;
+
+typedef struct {
+    uint8_t     iter;
+    led_flags_t flags;
+    bool        init;
+} effect_params_t;
+
+typedef struct {
+    hsv_t       hsv;
+    uint8_t     speed;
+    led_flags_t flags;
+} rgb_config_t;
+
+extern rgb_config_t rgb_matrix_config;
+
+#    define RGB_MATRIX_USE_LIMITS(min, max)                           \
+        uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter;    \
+        uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;             \
+        if (max > RGB_MATRIX_LED_COUNT) max = RGB_MATRIX_LED_COUNT;
+
+#    define RGB_MATRIX_TEST_LED_FLAGS() \
+        if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
+
+static inline bool rgb_matrix_check_finished_leds(uint8_t led_idx) {
+    return led_idx < RGB_MATRIX_LED_COUNT;
+}
+
+#    define rgb_matrix_hsv_to_rgb hsv_to_rgb
+
+// As QMK's lib8tion (FASTLED_SCALE8_FIXED)
+static inline uint8_t scale8(uint8_t i, uint8_t scale) {
+    return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8;
+}
+
+static inline uint16_t scale16by8(uint16_t i, uint8_t scale) {
+    return ((uint32_t)i * (1 + (uint32_t)scale)) >> 8;
+}
+
+static inline uint8_t qadd8(uint8_t i, uint8_t j) {
+    uint16_t t = i + j;
+    return t > 255 ? 255 : t;
+}
+
+static inline uint8_t qsub8(uint8_t i, uint8_t j) {
+    return i > j ? i - j : 0;
+}
+
+static inline uint8_t sqrt16(uint16_t x) {
+    if (x <= 1) {
+        return x;
+    }
+    uint8_t low = 1;
+    uint8_t hi  = x > 7904 ? 255 : (x >> 5) + 8;
+    do {
+        uint8_t mid = (low + hi) >> 1;
+        if ((uint16_t)(mid * mid) > x) {
+            hi = mid - 1;
+        } else {
+            if (mid == 255) {
+                return 255;
+            }
+            low = mid + 1;
+        }
+    } while (hi >= low);
+    return low - 1;
+}
+#endif
+
+// ============================== CALLBACKS ===================================
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record);
+bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
@@ -0,0 +1,180 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Stock QMK effects for comparison (host tests only), see rgb_matrix_effects.h
+
+#include "rgb_matrix_effects.h"
+#include "timer.h"
+
+uint8_t    g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
+last_hit_t g_last_hit_tracker;
+
+// ============================== HIT TRACKER =================================
+
+// As rgb_matrix_map_row_column_to_led() (one LED per key here)
+static uint8_t map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i) {
+    uint8_t led = g_led_config.matrix_co[row][column];
+    if (led == NO_LED) {
+        return 0;
+    }
+    led_i[0] = led;
+    return 1;
+}
+
+// As process_rgb_matrix() with RGB_MATRIX_KEYPRESSES
+void process_rgb_matrix_hits(uint8_t row, uint8_t col, bool pressed) {
+    uint8_t led[LED_HITS_TO_REMEMBER];
+    uint8_t led_count = 0;
+
+    if (pressed) {
+        led_count = map_row_column_to_led(row, col, led);
+    }
+
+    // Overlapping moves: memmove (QMK uses memcpy)
+    if (g_last_hit_tracker.count + led_count > LED_HITS_TO_REMEMBER) {
+        memmove(&g_last_hit_tracker.x[0], &g_last_hit_tracker.x[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memmove(&g_last_hit_tracker.y[0], &g_last_hit_tracker.y[led_count], LED_HITS_TO_REMEMBER - led_count);
+        memmove(&g_last_hit_tracker.tick[0], &g_last_hit_tracker.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2);
+        memmove(&g_last_hit_tracker.index[0], &g_last_hit_tracker.index[led_count], LED_HITS_TO_REMEMBER - led_count);
+        g_last_hit_tracker.count = LED_HITS_TO_REMEMBER - led_count;
+    }
+
+    for (uint8_t i = 0; i < led_count; i++) {
+        uint8_t index                   = g_last_hit_tracker.count;
+        g_last_hit_tracker.x[index]     = g_led_config.point[led[i]].x;
+        g_last_hit_tracker.y[index]     = g_led_config.point[led[i]].y;
+        g_last_hit_tracker.index[index] = led[i];
+        g_last_hit_tracker.tick[index]  = 0;
+        g_last_hit_tracker.count++;
+    }
+}
+
+// As the RGB_MATRIX_KEYREACTIVE_ENABLED part of rgb_task_timers()
+void rgb_matrix_hit_ticks(uint16_t delta_time) {
+    uint8_t count = g_last_hit_tracker.count;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (UINT16_MAX - delta_time < g_last_hit_tracker.tick[i]) {
+            g_last_hit_tracker.count--;
+            continue;
+        }
+        g_last_hit_tracker.tick[i] += delta_time;
+    }
+}
+
+// ============================== SOLID REACTIVE SIMPLE =======================
+
+typedef hsv_t (*reactive_f)(hsv_t hsv, uint16_t offset);
+
+// As effect_runner_reactive()
+static bool effect_runner_reactive(effect_params_t *params, reactive_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint16_t max_tick = 65535 / qadd8(rgb_matrix_config.speed, 1);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        uint16_t tick = max_tick;
+        // Reverse search to find most recent key hit
+        for (int8_t j = g_last_hit_tracker.count - 1; j >= 0; j--) {
+            if (g_last_hit_tracker.index[j] == i && g_last_hit_tracker.tick[j] < tick) {
+                tick = g_last_hit_tracker.tick[j];
+                break;
+            }
+        }
+
+        uint16_t offset = scale16by8(tick, qadd8(rgb_matrix_config.speed, 1));
+        rgb_t    rgb    = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, offset));
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
+static hsv_t SOLID_REACTIVE_SIMPLE_math(hsv_t hsv, uint16_t offset) {
+    hsv.v = scale8(255 - offset, hsv.v);
+    return hsv;
+}
+
+bool SOLID_REACTIVE_SIMPLE(effect_params_t *params) {
+    return effect_runner_reactive(params, &SOLID_REACTIVE_SIMPLE_math);
+}
+
+// ============================== TYPING HEATMAP ==============================
+
+#define RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS 25
+#define RGB_MATRIX_TYPING_HEATMAP_SPREAD 40
+#define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
+#define RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP 32
+
+void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
+    if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
+        return;
+    }
+    for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
+        for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+            if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
+                continue;
+            }
+            if (i_row == row && i_col == col) {
+                g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+            } else {
+                led_point_t a        = g_led_config.point[g_led_config.matrix_co[row][col]];
+                led_point_t b        = g_led_config.point[g_led_config.matrix_co[i_row][i_col]];
+                uint8_t     distance = sqrt16(((int16_t)(a.x - b.x) * (int16_t)(a.x - b.x)) + ((int16_t)(a.y - b.y) * (int16_t)(a.y - b.y)));
+                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+                    uint8_t amount = RGB_MATRIX_TYPING_HEATMAP_SPREAD - distance;
+                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+                    }
+                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
+                }
+            }
+        }
+    }
+}
+
+// A timer to track the last time we decremented all heatmap values.
+static uint16_t heatmap_decrease_timer;
+// Whether we should decrement the heatmap values during the next update.
+static bool decrease_heatmap_values;
+
+bool TYPING_HEATMAP(effect_params_t *params) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    if (params->init) {
+        rgb_matrix_set_color_all(0, 0, 0);
+        memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
+    }
+
+    // The heatmap animation might run in several iterations depending on
+    // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to update the
+    // timer when the animation starts.
+    if (params->iter == 0) {
+        decrease_heatmap_values = timer_elapsed(heatmap_decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+
+        // Restart the timer if we are going to decrease the heatmap this frame.
+        if (decrease_heatmap_values) {
+            heatmap_decrease_timer = timer_read();
+        }
+    }
+
+    // Render heatmap & decrease
+    uint8_t count = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS && count < RGB_MATRIX_LED_PROCESS_LIMIT; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS && RGB_MATRIX_LED_PROCESS_LIMIT; col++) {
+            if (g_led_config.matrix_co[row][col] >= led_min && g_led_config.matrix_co[row][col] < led_max) {
+                count++;
+                uint8_t val = g_rgb_frame_buffer[row][col];
+                if (!HAS_ANY_FLAGS(g_led_config.flags[g_led_config.matrix_co[row][col]], params->flags)) continue;
+
+                hsv_t hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+                rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
+                rgb_matrix_set_color(g_led_config.matrix_co[row][col], rgb.r, rgb.g, rgb.b);
+
+                if (decrease_heatmap_values) {
+                    g_rgb_frame_buffer[row][col] = qsub8(val, 1);
+                }
+            }
+        }
+    }
+
+    return rgb_matrix_check_finished_leds(led_max);
+}
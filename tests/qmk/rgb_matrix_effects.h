@@ -0,0 +1,40 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "quantum.h"
+
+/**
+ * @brief Stock QMK key reactive effects, to compare the kkb effects with (host tests only)
+ *
+ * typing_heatmap (RGB_MATRIX_FRAMEBUFFER_EFFECTS) and solid_reactive_simple
+ * (RGB_MATRIX_KEYPRESSES), transcribed from QMK's rgb_matrix.c and
+ * animations/ with their default settings.
+ */
+
+// Frame buffer of the framebuffer effects, as QMK's g_rgb_frame_buffer
+extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
+
+// Key hits of the reactive effects (LED_HITS_TO_REMEMBER), as QMK's last_hit_t
+#define LED_HITS_TO_REMEMBER 8
+
+typedef struct PACKED {
+    uint8_t  count;
+    uint8_t  x[LED_HITS_TO_REMEMBER];
+    uint8_t  y[LED_HITS_TO_REMEMBER];
+    uint8_t  index[LED_HITS_TO_REMEMBER];
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+} last_hit_t;
+
+extern last_hit_t g_last_hit_tracker;
+
+// Key press: hit tracker (process_rgb_matrix()) and heatmap
+void process_rgb_matrix_hits(uint8_t row, uint8_t col, bool pressed);
+void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col);
+
+// Time since the last frame, added to the hit ticks (rgb_task_timers())
+void rgb_matrix_hit_ticks(uint16_t delta_time);
+
+bool TYPING_HEATMAP(effect_params_t *params);
+bool SOLID_REACTIVE_SIMPLE(effect_params_t *params);
@@ -0,0 +1,8 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// QMK wait (host tests only), declared in quantum.h
+
+#include "quantum.h"
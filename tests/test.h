@@ -0,0 +1,50 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Checks and timing for the host tests
+ *
+ * CHECK() counts a check and prints the first failures, test_summary()
+ * prints the totals and returns the exit code. Benchmarks time a loop with
+ * test_now_ns(), and run when the test is started with --bench.
+ */
+
+// Failures printed, the rest are only counted
+#define TEST_MAX_PRINTED 20
+
+static unsigned test_checks   = 0;
+static unsigned test_failures = 0;
+
+#define CHECK(condition, ...)                                    \
+    do {                                                         \
+        test_checks++;                                           \
+        if (!(condition)) {                                      \
+            if (++test_failures <= TEST_MAX_PRINTED) {           \
+                printf("%s:%d: FAIL: ", __FILE__, __LINE__);     \
+                printf(__VA_ARGS__);                             \
+                printf("\n");                                    \
+            }                                                    \
+        }                                                        \
+    } while (0)
+
+static inline int test_summary(const char *name) {
+    printf("%s: %u checks, %u failed\n", name, test_checks, test_failures);
+    return test_failures ? 1 : 0;
+}
+
+static inline int test_bench_mode(int argc, char **argv) {
+    return argc > 1 && strcmp(argv[1], "--bench") == 0;
+}
+
+static inline uint64_t test_now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec;
+}
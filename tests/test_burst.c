@@ -0,0 +1,289 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Burst macro output (burst_macro.c): the keyboard reports sent by
+// kkb_burst_send_string(), decoded as the host reads them (modifiers, then
+// the newly pressed keys in usage order), must give the string back. Keys
+// are packed into a report only while their usages increase, with the same
+// modifiers, up to KKB_BURST_MAX_KEYS. send_string() and the character
+// tables are QMK's (US layout, qmk_stubs.c), with ^ and ` as dead keys here.
+
+#include <stdlib.h>
+
+#include "test.h"
+#include "host_stubs.h"
+#include "send_string.h"
+#include "burst_macro.h"
+
+#define SHIFT MOD_BIT(KC_LEFT_SHIFT)
+#define ALTGR MOD_BIT(KC_RIGHT_ALT)
+
+// Dead keys: typed serially, followed by a space
+// clang-format off
+const uint8_t ascii_to_dead_lut[16] = {
+    [0x5E / 8] = 1 << (0x5E % 8), // ^
+    [0x60 / 8] = 1 << (0x60 % 8), // `
+};
+// clang-format on
+
+// ============================== HOST ========================================
+
+typedef struct {
+    uint8_t mods;
+    uint8_t keys[32]; // Bit map of the usages
+} report_t;
+
+static report_t reports[2048];
+static uint16_t report_count;
+static report_t report;
+static uint8_t  report_weak_mods;
+static bool     host_nkro = true;
+
+static bool report_key(const report_t *r, uint8_t key) {
+    return r->keys[key / 8] & (1 << (key % 8));
+}
+
+static uint8_t report_key_count(const report_t *r) {
+    uint8_t count = 0;
+    for (uint16_t key = 0; key < 256; key++) {
+        count += report_key(r, key);
+    }
+    return count;
+}
+
+void add_key(uint8_t key) {
+    report.keys[key / 8] |= 1 << (key % 8);
+}
+
+void del_key(uint8_t key) {
+    report.keys[key / 8] &= ~(1 << (key % 8));
+}
+
+void add_mods(uint8_t mods) {
+    report.mods |= mods;
+}
+
+void del_mods(uint8_t mods) {
+    report.mods &= ~mods;
+}
+
+void set_weak_mods(uint8_t mods) {
+    report_weak_mods = mods;
+}
+
+void send_keyboard_report(void) {
+    if (report_count < sizeof(reports) / sizeof(reports[0])) {
+        reports[report_count]      = report;
+        reports[report_count].mods = report.mods | report_weak_mods;
+    }
+    report_count++;
+}
+
+bool host_can_send_nkro(void) {
+    return host_nkro;
+}
+
+// As QMK's register_code() / unregister_code() for basic keys and modifiers
+void register_code(uint8_t kc) {
+    if (IS_MODIFIER_KEYCODE(kc)) {
+        add_mods(MOD_BIT(kc));
+    } else {
+        add_key(kc);
+    }
+    send_keyboard_report();
+}
+
+void unregister_code(uint8_t kc) {
+    if (IS_MODIFIER_KEYCODE(kc)) {
+        del_mods(MOD_BIT(kc));
+    } else {
+        del_key(kc);
+    }
+    send_keyboard_report();
+}
+
+static void reset(bool nkro) {
+    memset(&report, 0, sizeof(report));
+    report_weak_mods = 0;
+    report_count     = 0;
+    host_nkro        = nkro;
+}
+
+// ============================== DECODING ====================================
+
+static bool char_dead(uint8_t c) {
+    return PGM_LOADBIT(ascii_to_dead_lut, c);
+}
+
+// Character typed by a key with the modifiers, 0 when none
+static char char_of(uint8_t keycode, uint8_t mods) {
+    bool shift = mods & (SHIFT | MOD_BIT(KC_RIGHT_SHIFT));
+    bool altgr = mods & ALTGR;
+    for (uint8_t c = 1; c < 128; c++) {
+        if (ascii_to_keycode_lut[c] == keycode && PGM_LOADBIT(ascii_to_shift_lut, c) == shift && PGM_LOADBIT(ascii_to_altgr_lut, c) == altgr) {
+            return c;
+        }
+    }
+    return 0;
+}
+
+// Text read by the host from the reports: new keys of a report in usage order
+static void decode(char *text, size_t size) {
+    report_t prev = {0};
+    size_t   len  = 0;
+    bool     dead = false;
+
+    for (uint16_t r = 0; r < report_count && r < sizeof(reports) / sizeof(reports[0]); r++) {
+        for (uint16_t key = 0; key < 256; key++) {
+            if (!report_key(&reports[r], key) || report_key(&prev, key)) {
+                continue;
+            }
+            char c = char_of(key, reports[r].mods);
+            if (dead && c == ' ') {
+                // Space after a dead key: the dead character itself
+                dead = false;
+                continue;
+            }
+            dead = c && char_dead(c);
+            if (len + 1 < size) {
+                text[len++] = c ? c : '?';
+            }
+        }
+        prev = reports[r];
+    }
+    text[len] = '\0';
+}
+
+// ============================== PACKING RULE ================================
+
+// Reports of send_char() for a character
+static uint16_t serial_reports(uint8_t c) {
+    return 2 + 2 * PGM_LOADBIT(ascii_to_shift_lut, c) + 2 * PGM_LOADBIT(ascii_to_altgr_lut, c) + 2 * char_dead(c);
+}
+
+// Reports for a string: a group takes the next character while its usage is
+// higher than the last one's, with the same modifiers, up to KKB_BURST_MAX_KEYS
+static uint16_t expected_reports(const char *str) {
+    uint16_t count       = 0;
+    uint8_t  group_count = 0, group_last = 0, group_mods = 0;
+
+    for (; *str; str++) {
+        uint8_t c       = (uint8_t)*str;
+        uint8_t keycode = ascii_to_keycode_lut[c];
+        uint8_t mods    = (PGM_LOADBIT(ascii_to_shift_lut, c) ? SHIFT : 0) | (PGM_LOADBIT(ascii_to_altgr_lut, c) ? ALTGR : 0);
+
+        if (char_dead(c) || keycode == KC_NO) {
+            count += group_count ? 2 : 0;
+            group_count = 0;
+            count += serial_reports(c);
+            continue;
+        }
+        if (group_count > 0 && (mods != group_mods || keycode <= group_last || group_count == KKB_BURST_MAX_KEYS)) {
+            count += 2;
+            group_count = 0;
+        }
+        group_count++;
+        group_last = keycode;
+        group_mods = mods;
+    }
+    return count + (group_count ? 2 : 0);
+}
+
+// Type a string, check the text read by the host, the reports and the final state
+static void check_string(const char *str, bool nkro) {
+    char text[512];
+
+    reset(nkro);
+    kkb_burst_send_string(str);
+    decode(text, sizeof(text));
+
+    CHECK(strcmp(text, str) == 0, "\"%s\" read as \"%s\"", str, text);
+    CHECK(report_key_count(&report) == 0 && (report.mods | report_weak_mods) == 0, "\"%s\": keys or modifiers left down", str);
+    for (uint16_t r = 0; r < report_count; r++) {
+        CHECK(report_key_count(&reports[r]) <= (nkro ? KKB_BURST_MAX_KEYS : 1), "\"%s\": report %u has %u keys", str, r, report_key_count(&reports[r]));
+    }
+    if (nkro) {
+        CHECK(report_count == expected_reports(str), "\"%s\": %u reports, expected %u", str, report_count, expected_reports(str));
+    }
+}
+
+// ============================== CHECKS ======================================
+
+static void check_packing(void) {
+    // Increasing usages in one press report, released in the next
+    reset(true);
+    kkb_burst_send_string("abc");
+    CHECK(report_count == 2, "\"abc\": %u reports, expected 2", report_count);
+    CHECK(report_key_count(&reports[0]) == 3 && report_key(&reports[0], KC_A) && report_key(&reports[0], KC_C), "\"abc\": not pressed together");
+    CHECK(report_key_count(&reports[1]) == 0, "\"abc\": not released together");
+
+    // Decreasing usage, repeated key, modifier change, full report: a new group each
+    check_string("cab", true);
+    check_string("aa", true);
+    check_string("aA", true);
+    check_string("abcdefghijklmnop", true);
+    reset(true);
+    kkb_burst_send_string("cab");
+    CHECK(report_count == 4, "\"cab\": %u reports, expected 4", report_count);
+    reset(true);
+    kkb_burst_send_string("abcdefgh");
+    CHECK(report_count == 4 && report_key_count(&reports[0]) == KKB_BURST_MAX_KEYS, "\"abcdefgh\": %u reports, %u keys in the first", report_count, report_key_count(&reports[0]));
+
+    // The release report carries the next group's modifiers
+    reset(true);
+    kkb_burst_send_string("Ab");
+    CHECK(report_count == 4, "\"Ab\": %u reports, expected 4", report_count);
+    CHECK(reports[0].mods == SHIFT && reports[1].mods == 0 && reports[2].mods == 0, "\"Ab\": modifiers %02X %02X %02X", reports[0].mods, reports[1].mods, reports[2].mods);
+
+    // Dead keys and control characters in between
+    check_string("a^b`c", true);
+    check_string("line one\nline two\ttab", true);
+    check_string("", true);
+    check_string(KKB_BURST_BENCH_TEXT, true);
+}
+
+static void check_serial(void) {
+    // Without NKRO: send_string(), one key per report
+    check_string(KKB_BURST_BENCH_TEXT, false);
+    check_string("aA^b", false);
+}
+
+static void check_random(void) {
+    static const char charset[] = " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~\n\t";
+    char              str[48];
+
+    srand(1);
+    for (uint16_t i = 0; i < 20000; i++) {
+        uint8_t len = rand() % (sizeof(str) - 1);
+        for (uint8_t j = 0; j < len; j++) {
+            // Mostly lowercase, as typed text
+            str[j] = rand() % 4 ? 'a' + rand() % 26 : charset[rand() % (sizeof(charset) - 1)];
+        }
+        str[len] = '\0';
+        check_string(str, true);
+    }
+}
+
+static void check_combo(void) {
+    static const uint8_t combo[] = {KC_LSFT, KC_LWIN, KC_S};
+
+    reset(true);
+    kkb_burst_combo(combo, sizeof(combo), true);
+    CHECK(report_count == 1 && reports[0].mods == (SHIFT | MOD_BIT(KC_LWIN)) && report_key_count(&reports[0]) == 1 && report_key(&reports[0], KC_S), "combo press: %u reports", report_count);
+    kkb_burst_combo(combo, sizeof(combo), false);
+    CHECK(report_count == 2 && reports[1].mods == 0 && report_key_count(&reports[1]) == 0, "combo release: %u reports", report_count);
+}
+
+// Console output of the benchmark, not checked
+int host_printf(const char *format, ...) {
+    (void)format;
+    return 0;
+}
+
+int main(void) {
+    check_packing();
+    check_serial();
+    check_random();
+    check_combo();
+    return test_summary("burst");
+}
@@ -0,0 +1,283 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// code1 keymap LED indicators: rgb_matrix_indicators_advanced_user() (and
+// through it kkb_set_layer_key_colors()) for every layer, default layer, Caps
+// Lock state and brightness, against colors computed here from the dense
+// keymaps[], and the brightness keys. With --bench: rgb_matrix_set_color()
+// calls and time per frame.
+
+#include "test.h"
+#include "host_stubs.h"
+
+// Layers of the code1 keymap (enum kkb_layers in keymap.c)
+enum { L_BASE, L_CODE, L_B_FN1, L_B_FN2, L_C_FN1, L_C_FN2, L_C_FN3, L_C_FN4, L_C_CF1, L_C_CF2, LAYER_COUNT };
+
+// Layer colors (keymap.c)
+static const hsv_t color_caps         = {HSV_ORANGE};
+static const hsv_t color_win_standard = {HSV_GOLDENROD};
+static const hsv_t color_brghtscale   = {HSV_CYAN};
+static const hsv_t color_win_special  = {HSV_BLUE};
+static const hsv_t color_win_fn       = {HSV_BLUE};
+static const hsv_t color_fn_active    = {HSV_GREEN};
+static const hsv_t color_fn_controls  = {HSV_SPRINGGREEN};
+static const hsv_t color_sys          = {HSV_WHITE};
+static const rgb_t color_off          = {RGB_OFF};
+static const rgb_t color_unset        = {1, 2, 3};
+
+// Instrumentation from the keyboard (stall_watch.c), not under test
+void kkb_stall_enter(uint8_t section) {
+    (void)section;
+}
+
+void kkb_stall_leave(void) {}
+
+void keyboard_deferred_init_user(void);
+
+static keypos_t led_position[RGB_MATRIX_LED_COUNT];
+
+// Color of a layer color at a brightness, brightness as the uint8_t of kkb_get_brightness()
+static rgb_t expected_color(hsv_t hsv, int brightness) {
+    uint8_t value = (uint8_t)brightness;
+    if (value == 0) {
+        return color_off;
+    }
+    hsv.v = MIN(KKB_BRIGHT_MAX, MAX(KKB_BRIGHT_MIN, value));
+    return hsv_to_rgb(hsv);
+}
+
+// Effective keycode: highest active layer that is not KC_TRNS
+static uint16_t expected_keycode(layer_state_t state, uint8_t row, uint8_t col) {
+    for (int layer = LAYER_COUNT - 1; layer >= 0; layer--) {
+        uint16_t keycode = keycode_at_keymap_location_raw(layer, row, col);
+        if ((state & (1UL << layer)) && keycode != KC_TRNS) {
+            return keycode;
+        }
+    }
+    return keycode_at_keymap_location_raw(0, row, col);
+}
+
+static void expected_layer_keys(rgb_t *frame, uint8_t layer, uint8_t brightness, bool caps, bool inactive_off) {
+    rgb_t active   = expected_color(color_fn_active, brightness + KKB_BRIGHT_DIFF_FN_ACTIVE);
+    rgb_t controls = expected_color(color_fn_controls, brightness + KKB_BRIGHT_DIFF_FN_ACTIVE);
+    rgb_t noop     = inactive_off ? color_off : expected_color(caps ? color_caps : color_win_fn, brightness + KKB_BRIGHT_DIFF_FN_OFF);
+
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        uint16_t keycode = keycode_at_keymap_location_raw(layer, led_position[led].row, led_position[led].col);
+        frame[led]       = keycode > KC_TRNS ? active : keycode == KC_TRNS ? controls : noop;
+    }
+}
+
+// The frame for a layer state, from the keymap and the layer colors
+static void expected_frame(rgb_t *frame, layer_state_t state, uint8_t brightness, bool caps) {
+    uint8_t layer = get_highest_layer(state);
+
+    switch (layer) {
+        case L_BASE:
+        case L_CODE: {
+            rgb_t base      = expected_color(layer == L_CODE ? color_win_special : color_win_standard, brightness);
+            rgb_t caps_keys = expected_color(color_caps, brightness + KKB_BRIGHT_DIFF_CAPS);
+            for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+                frame[led] = (caps && (g_led_config.flags[led] & LED_FLAG_KEYLIGHT)) ? caps_keys : base;
+            }
+            break;
+        }
+
+        case L_C_CF1: {
+            expected_layer_keys(frame, layer, brightness, caps, true);
+
+            // Brightness indicator on the number row, 10% per key
+            uint8_t percent = (brightness - KKB_BRIGHT_MIN_MAIN) * 100 / (KKB_BRIGHT_MAX_MAIN - KKB_BRIGHT_MIN_MAIN);
+            for (uint8_t i = 0; i < KKB_NUM_ROW_COUNT && i < percent / INDICATOR_STEP_PERCENT; i++) {
+                frame[KKB_NUM_ROW_START + i] = expected_color(color_brghtscale, brightness + KKB_BRIGHT_DIFF_FN_ACTIVE);
+            }
+
+            for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+                uint16_t keycode = expected_keycode(state, led_position[led].row, led_position[led].col);
+                if (keycode == MO(L_C_CF2)) {
+                    frame[led] = expected_color(color_sys, KKB_BRIGHT_MAX);
+                } else if (caps && keycode == KC_CAPS) {
+                    frame[led] = expected_color(color_caps, KKB_BRIGHT_MAX);
+                }
+            }
+            break;
+        }
+
+        case L_C_CF2:
+            expected_layer_keys(frame, layer, brightness, caps, true);
+            for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+                if (keycode_at_keymap_location_raw(layer, led_position[led].row, led_position[led].col) > KC_TRNS) {
+                    frame[led] = expected_color(color_sys, KKB_BRIGHT_MAX);
+                }
+            }
+            break;
+
+        default:
+            expected_layer_keys(frame, layer, brightness, caps, false);
+            break;
+    }
+}
+
+static void set_state(layer_state_t default_state, layer_state_t state, uint8_t brightness, bool caps) {
+    default_layer_state = default_state;
+    layer_state         = state;
+    host_eeconfig_user  = brightness;
+    keyboard_deferred_init_user();
+    host_led_state.caps_lock = caps;
+}
+
+// Render in chunks of chunk LEDs (as RGB_MATRIX_LED_PROCESS_LIMIT), LEDs outside a chunk must not change
+static void render(uint8_t chunk) {
+    rgb_t before[RGB_MATRIX_LED_COUNT];
+
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        host_leds[led] = color_unset;
+    }
+
+    for (uint8_t led_min = 0; led_min < RGB_MATRIX_LED_COUNT; led_min += chunk) {
+        uint8_t led_max = MIN(RGB_MATRIX_LED_COUNT, led_min + chunk);
+
+        memcpy(before, host_leds, sizeof(before));
+        rgb_matrix_indicators_advanced_user(led_min, led_max);
+        for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+            CHECK((led >= led_min && led < led_max) || !memcmp(&host_leds[led], &before[led], sizeof(rgb_t)), "LED %u set outside %u-%u", led, led_min, led_max);
+        }
+    }
+}
+
+static void check_frame(layer_state_t default_state, layer_state_t state, uint8_t brightness, bool caps, uint8_t chunk) {
+    rgb_t expected[RGB_MATRIX_LED_COUNT];
+
+    set_state(default_state, state, brightness, caps);
+    expected_frame(expected, state | default_state, brightness, caps);
+    render(chunk);
+
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        const rgb_t *got  = &host_leds[led];
+        const rgb_t *want = &expected[led];
+        CHECK(!memcmp(got, want, sizeof(rgb_t)), "default 0x%lX layers 0x%lX brightness %u caps %u chunk %u: LED %u is %u,%u,%u, expected %u,%u,%u", (unsigned long)default_state, (unsigned long)state, brightness, caps, chunk, led, got->r, got->g, got->b, want->r, want->g, want->b);
+    }
+}
+
+// The sparse lookup (keymap_sparse.c) against the dense keymaps[]
+static void check_lookup(void) {
+    CHECK(keymap_layer_count() == keymap_layer_count_raw(), "keymap_layer_count() %u, keymaps[] has %u layers", keymap_layer_count(), keymap_layer_count_raw());
+    CHECK(keymap_layer_count_raw() == LAYER_COUNT, "keymaps[] has %u layers, expected %u", keymap_layer_count_raw(), LAYER_COUNT);
+
+    for (uint8_t layer = 0; layer <= LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row <= MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col <= MATRIX_COLS; col++) {
+                uint16_t keycode = keycode_at_keymap_location(layer, row, col);
+                uint16_t dense   = keycode_at_keymap_location_raw(layer, row, col);
+                CHECK(keycode == dense, "layer %u [%u,%u]: 0x%04X, keymaps[] 0x%04X", layer, row, col, keycode, dense);
+            }
+        }
+    }
+}
+
+// RM_VALU / RM_VALD (process_record_user(), kkb_update_brightness()): one step per press, within the main range, saved
+static void check_brightness_keys(void) {
+    keyrecord_t press   = {.event.pressed = true};
+    keyrecord_t release = {.event.pressed = false};
+
+    // Base layer: left to QMK
+    set_state(1UL << L_BASE, 0, KKB_BRIGHT_START, false);
+    host_eeconfig_user = 0;
+    CHECK(process_record_user(RM_VALU, &press), "RM_VALU handled on the base layer");
+    CHECK(process_record_user(RM_VALU, &release), "RM_VALU release handled on the base layer");
+    CHECK(host_eeconfig_user == 0, "brightness saved on the base layer");
+
+    set_state(1UL << L_CODE, 0, KKB_BRIGHT_START, false);
+    CHECK(!process_record_user(RM_VALU, &press), "RM_VALU not handled");
+    CHECK(host_eeconfig_user == KKB_BRIGHT_START + KKB_BRIGHT_STEP, "RM_VALU saved %lu", (unsigned long)host_eeconfig_user);
+
+    // Held (repeated press without release): no second step
+    process_record_user(RM_VALU, &press);
+    CHECK(host_eeconfig_user == KKB_BRIGHT_START + KKB_BRIGHT_STEP, "held RM_VALU saved %lu", (unsigned long)host_eeconfig_user);
+    CHECK(!process_record_user(RM_VALU, &release), "RM_VALU release not handled");
+
+    for (uint8_t i = 0; i < 255 / KKB_BRIGHT_STEP; i++) {
+        process_record_user(RM_VALU, &press);
+        process_record_user(RM_VALU, &release);
+    }
+    CHECK(host_eeconfig_user == KKB_BRIGHT_MAX_MAIN, "RM_VALU stopped at %lu", (unsigned long)host_eeconfig_user);
+
+    // At the limit nothing is written
+    host_eeconfig_user = 0;
+    process_record_user(RM_VALU, &press);
+    process_record_user(RM_VALU, &release);
+    CHECK(host_eeconfig_user == 0, "RM_VALU saved %lu at the limit", (unsigned long)host_eeconfig_user);
+
+    for (uint8_t i = 0; i < 255 / KKB_BRIGHT_STEP; i++) {
+        process_record_user(RM_VALD, &press);
+        process_record_user(RM_VALD, &release);
+    }
+    CHECK(host_eeconfig_user == KKB_BRIGHT_MIN_MAIN, "RM_VALD stopped at %lu", (unsigned long)host_eeconfig_user);
+
+    CHECK(process_record_user(KC_A, &press), "KC_A handled");
+}
+
+static void run_tests(void) {
+    static const uint8_t brightness[] = {KKB_BRIGHT_MIN_MAIN, KKB_BRIGHT_START, KKB_BRIGHT_MAX_MAIN};
+    static const uint8_t chunks[]     = {RGB_MATRIX_LED_COUNT, 16};
+
+    check_lookup();
+    check_brightness_keys();
+
+    for (uint8_t base = L_BASE; base <= L_CODE; base++) {
+        for (uint8_t layer = L_BASE; layer < LAYER_COUNT; layer++) {
+            // The layer alone, and with all layers between the base and it
+            layer_state_t alone = layer > base ? 1UL << layer : 0;
+            layer_state_t stack = layer > base ? ((2UL << layer) - 1) & ~((2UL << base) - 1) : 0;
+
+            for (uint8_t caps = 0; caps <= 1; caps++) {
+                for (uint8_t i = 0; i < sizeof(brightness); i++) {
+                    for (uint8_t chunk = 0; chunk < sizeof(chunks); chunk++) {
+                        check_frame(1UL << base, alone, brightness[i], caps, chunks[chunk]);
+                        check_frame(1UL << base, stack, brightness[i], caps, chunks[chunk]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void run_bench(void) {
+    static const uint32_t frames = 20000;
+
+    printf("%-6s %-5s %12s %12s\n", "layer", "caps", "calls/frame", "ns/frame");
+    for (uint8_t layer = L_BASE; layer < LAYER_COUNT; layer++) {
+        for (uint8_t caps = 0; caps <= 1; caps++) {
+            set_state(1UL << L_CODE, layer > L_CODE ? 1UL << layer : 0, KKB_BRIGHT_START, caps);
+            rgb_matrix_indicators_advanced_user(0, RGB_MATRIX_LED_COUNT);
+
+            host_led_calls = 0;
+            uint64_t start = test_now_ns();
+            for (uint32_t frame = 0; frame < frames; frame++) {
+                rgb_matrix_indicators_advanced_user(0, RGB_MATRIX_LED_COUNT);
+            }
+            uint64_t elapsed = test_now_ns() - start;
+
+            printf("%-6u %-5u %12lu %12.0f\n", layer, caps, (unsigned long)(host_led_calls / frames), (double)elapsed / frames);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led != NO_LED) {
+                led_position[led] = (keypos_t){.col = col, .row = row};
+            }
+        }
+    }
+
+    if (test_bench_mode(argc, argv)) {
+        run_bench();
+        return 0;
+    }
+
+    run_tests();
+    return test_summary("code1_rgb");
+}
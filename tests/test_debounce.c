@@ -0,0 +1,278 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Adaptive debounce (adaptive_debounce.c): synthetic bounce sequences through
+// debounce(), scanned every millisecond unless a test says otherwise.
+
+#include <stdlib.h>
+
+#include "test.h"
+#include "host_stubs.h"
+#include "debounce.h"
+#include "adaptive_debounce.h"
+
+static matrix_row_t raw[MATRIX_ROWS];
+static matrix_row_t cooked[MATRIX_ROWS];
+static matrix_row_t last_raw[MATRIX_ROWS];
+
+static void reset(uint32_t start_ms) {
+    host_timer_ms = start_ms;
+    memset(raw, 0, sizeof(raw));
+    memset(cooked, 0, sizeof(cooked));
+    memset(last_raw, 0, sizeof(last_raw));
+    debounce_init(MATRIX_ROWS);
+    kkb_debounce_reset_stats();
+}
+
+// One scan after ms milliseconds, changed as the matrix scan reports it
+static bool scan(uint16_t ms) {
+    host_timer_ms += ms;
+    bool changed = memcmp(raw, last_raw, sizeof(raw)) != 0;
+    memcpy(last_raw, raw, sizeof(raw));
+    return debounce(raw, cooked, MATRIX_ROWS, changed);
+}
+
+static void set_key(uint8_t row, uint8_t col, bool pressed) {
+    if (pressed) {
+        raw[row] |= MATRIX_ROW_SHIFTER << col;
+    } else {
+        raw[row] &= ~(MATRIX_ROW_SHIFTER << col);
+    }
+}
+
+static bool cooked_key(uint8_t row, uint8_t col) {
+    return cooked[row] & (MATRIX_ROW_SHIFTER << col);
+}
+
+static uint8_t key_debounce_ms(uint8_t row, uint8_t col) {
+    kkb_debounce_stats_t stats;
+    kkb_debounce_get_stats(row, col, &stats);
+    return stats.debounce_ms;
+}
+
+// Scans until the key's debounced state changes, returns the ms it took (0xFFFF: no change in limit ms)
+static uint16_t ms_until_change(uint8_t row, uint8_t col, uint16_t limit) {
+    bool before = cooked_key(row, col);
+    for (uint16_t ms = 1; ms <= limit; ms++) {
+        scan(1);
+        if (cooked_key(row, col) != before) {
+            return ms;
+        }
+    }
+    return 0xFFFF;
+}
+
+// Press and release with no bounce, each held until debounced
+static void clean_tap(uint8_t row, uint8_t col) {
+    set_key(row, col, true);
+    scan(1);
+    ms_until_change(row, col, KKB_DEBOUNCE_MAX + 1);
+    set_key(row, col, false);
+    scan(1);
+    ms_until_change(row, col, KKB_DEBOUNCE_MAX + 1);
+}
+
+// Press that bounces 3 times, 1 ms apart, then stays down until debounced
+static void bouncy_press(uint8_t row, uint8_t col) {
+    for (uint8_t i = 0; i < 3; i++) {
+        set_key(row, col, true);
+        scan(1);
+        set_key(row, col, false);
+        scan(1);
+    }
+    set_key(row, col, true);
+    scan(1);
+    ms_until_change(row, col, KKB_DEBOUNCE_MAX + 1);
+}
+
+static void check_clean_press(void) {
+    reset(1000);
+
+    set_key(1, 2, true);
+    CHECK(!scan(1), "change reported on the first raw change");
+    // The first scan starts the window, the change is committed the start time later
+    CHECK(ms_until_change(1, 2, 100) == KKB_DEBOUNCE_START, "clean press not debounced in %u ms", KKB_DEBOUNCE_START);
+    CHECK(!scan(1), "change reported again");
+
+    set_key(1, 2, false);
+    scan(1);
+    CHECK(ms_until_change(1, 2, 100) == KKB_DEBOUNCE_START, "clean release not debounced in %u ms", KKB_DEBOUNCE_START);
+    CHECK(key_debounce_ms(1, 2) == KKB_DEBOUNCE_START, "clean key changed its debounce time to %u", key_debounce_ms(1, 2));
+
+    kkb_debounce_stats_t stats;
+    kkb_debounce_get_stats(1, 2, &stats);
+    CHECK(stats.changes == 2 && stats.bounces == 0, "clean key: %u changes, %u bounces", stats.changes, stats.bounces);
+}
+
+static void check_bounce(void) {
+    reset(2000);
+
+    // Press bounces 3 times (6 transitions, 1 ms apart): one change, after the last transition
+    for (uint8_t i = 0; i < 3; i++) {
+        set_key(0, 5, true);
+        scan(1);
+        CHECK(!cooked_key(0, 5), "press committed while bouncing");
+        set_key(0, 5, false);
+        scan(1);
+        CHECK(!cooked_key(0, 5), "press committed while bouncing");
+    }
+    set_key(0, 5, true);
+    scan(1);
+    CHECK(ms_until_change(0, 5, 100) == KKB_DEBOUNCE_START, "bouncy press not debounced %u ms after the last transition", KKB_DEBOUNCE_START);
+
+    kkb_debounce_stats_t stats;
+    kkb_debounce_get_stats(0, 5, &stats);
+    CHECK(stats.changes == 1, "bouncy press: %u changes", stats.changes);
+    CHECK(stats.bounces == 6, "bouncy press: %u bounces, expected 6", stats.bounces);
+    CHECK(stats.max_bounce == 6, "bouncy press: max bounce %u ms, expected 6", stats.max_bounce);
+    CHECK(stats.debounce_ms == KKB_DEBOUNCE_START + 1, "bouncy key debounce time %u, expected %u", stats.debounce_ms, KKB_DEBOUNCE_START + 1);
+
+    // Dropout shorter than the debounce time while held: no release
+    set_key(0, 5, false);
+    scan(1);
+    scan(1);
+    set_key(0, 5, true);
+    for (uint8_t ms = 0; ms < 50; ms++) {
+        scan(1);
+        CHECK(cooked_key(0, 5), "dropout of 2 ms released the key");
+    }
+
+    kkb_debounce_dump_stats();
+
+    // Bounces 3 ms apart, under the debounce time: each restarts the window
+    set_key(1, 7, true);
+    for (uint8_t i = 0; i < 4; i++) {
+        set_key(1, 7, !(i & 1));
+        for (uint8_t ms = 0; ms < 3; ms++) {
+            scan(1);
+            CHECK(!cooked_key(1, 7), "press committed %u ms after a bounce", ms);
+        }
+    }
+    set_key(1, 7, true);
+    scan(1);
+    CHECK(ms_until_change(1, 7, 100) == KKB_DEBOUNCE_START, "slow bouncy press not debounced %u ms after the last transition", KKB_DEBOUNCE_START);
+}
+
+static void check_adaptation(void) {
+    reset(3000);
+
+    // Bounces raise the time up to the maximum
+    for (uint8_t i = 0; i < KKB_DEBOUNCE_MAX + 5; i++) {
+        bouncy_press(2, 3);
+        set_key(2, 3, false);
+        scan(1);
+        ms_until_change(2, 3, KKB_DEBOUNCE_MAX + 1);
+    }
+    CHECK(key_debounce_ms(2, 3) == KKB_DEBOUNCE_MAX, "bouncy key debounce time %u, expected the maximum %u", key_debounce_ms(2, 3), KKB_DEBOUNCE_MAX);
+
+    // KKB_DEBOUNCE_CLEAN_STEPS clean changes lower it by 1 ms
+    for (uint16_t i = 0; i < KKB_DEBOUNCE_CLEAN_STEPS / 2; i++) {
+        clean_tap(2, 3);
+    }
+    CHECK(key_debounce_ms(2, 3) == KKB_DEBOUNCE_MAX - 1, "debounce time %u after %u clean changes, expected %u", key_debounce_ms(2, 3), KKB_DEBOUNCE_CLEAN_STEPS, KKB_DEBOUNCE_MAX - 1);
+
+    // Clean presses lower it down to the minimum
+    for (uint16_t i = 0; i < KKB_DEBOUNCE_CLEAN_STEPS * (KKB_DEBOUNCE_MAX - KKB_DEBOUNCE_MIN + 2) / 2; i++) {
+        clean_tap(2, 3);
+    }
+    CHECK(key_debounce_ms(2, 3) == KKB_DEBOUNCE_MIN, "clean key debounce time %u, expected the minimum %u", key_debounce_ms(2, 3), KKB_DEBOUNCE_MIN);
+
+    // Statistics reset keeps the adapted time
+    kkb_debounce_reset_stats();
+    kkb_debounce_stats_t stats;
+    kkb_debounce_get_stats(2, 3, &stats);
+    CHECK(stats.changes == 0 && stats.bounces == 0 && stats.debounce_ms == KKB_DEBOUNCE_MIN, "reset: %u changes, %u bounces, %u ms", stats.changes, stats.bounces, stats.debounce_ms);
+
+    // Other keys are not affected
+    CHECK(key_debounce_ms(2, 4) == KKB_DEBOUNCE_START, "neighbour key debounce time %u", key_debounce_ms(2, 4));
+}
+
+static void check_independent_keys(void) {
+    reset(4000);
+
+    // A key that keeps bouncing does not hold back a clean key
+    set_key(3, 0, true);
+    scan(1);
+    set_key(4, 15, true);
+    scan(1);
+    for (uint8_t ms = 2; ms <= KKB_DEBOUNCE_START + 1; ms++) {
+        set_key(3, 0, ms & 1);
+        scan(1);
+    }
+    CHECK(cooked_key(4, 15), "clean key held back by a bouncing key");
+    CHECK(!cooked_key(3, 0), "bouncing key committed");
+}
+
+static void check_scan_gaps(void) {
+    // Scans further apart than 1 ms, across the 16-bit timer wrap
+    reset(0xFFFF - 2);
+
+    set_key(1, 1, true);
+    scan(1);
+    scan(3);
+    CHECK(!cooked_key(1, 1), "committed after 3 of %u ms", KKB_DEBOUNCE_START);
+    scan(3);
+    CHECK(cooked_key(1, 1), "not committed after 6 of %u ms", KKB_DEBOUNCE_START);
+
+    // Idle: nothing reported
+    for (uint8_t i = 0; i < 10; i++) {
+        CHECK(!scan(7), "change reported while idle");
+    }
+}
+
+// Random presses and releases with bounce bursts shorter than the gap between them:
+// every change is committed once, and the debounced state follows the raw state
+static void check_random(void) {
+    srand(1);
+    reset(5000);
+
+    uint16_t expected_changes[MATRIX_ROWS * MATRIX_COLS] = {0};
+
+    for (uint16_t step = 0; step < 20000; step++) {
+        uint8_t row = rand() % MATRIX_ROWS;
+        uint8_t col = rand() % MATRIX_COLS;
+        bool    now = !(raw[row] & (MATRIX_ROW_SHIFTER << col));
+
+        // Burst of up to 4 transitions ending in the new state, then stable
+        uint8_t bounces = rand() % 3;
+        for (uint8_t i = 0; i < bounces; i++) {
+            set_key(row, col, now);
+            scan(1);
+            set_key(row, col, !now);
+            scan(1);
+        }
+        set_key(row, col, now);
+        expected_changes[row * MATRIX_COLS + col]++;
+
+        // Stable for the maximum time, other keys untouched
+        for (uint8_t ms = 0; ms <= KKB_DEBOUNCE_MAX + 1; ms++) {
+            scan(1 + rand() % 2);
+        }
+        CHECK(cooked[row] == raw[row], "step %u: row %u cooked 0x%04X, raw 0x%04X", step, row, cooked[row], raw[row]);
+    }
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            kkb_debounce_stats_t stats;
+            kkb_debounce_get_stats(row, col, &stats);
+            CHECK(stats.changes == expected_changes[row * MATRIX_COLS + col], "[%u,%u]: %u changes, expected %u", row, col, stats.changes, expected_changes[row * MATRIX_COLS + col]);
+            CHECK(stats.debounce_ms >= KKB_DEBOUNCE_MIN && stats.debounce_ms <= KKB_DEBOUNCE_MAX, "[%u,%u]: debounce time %u", row, col, stats.debounce_ms);
+        }
+    }
+}
+
+// Console output of the statistics dump, not checked
+int host_printf(const char *format, ...) {
+    (void)format;
+    return 0;
+}
+
+int main(void) {
+    check_clean_press();
+    check_bounce();
+    check_adaptation();
+    check_independent_keys();
+    check_scan_gaps();
+    check_random();
+    return test_summary("debounce");
+}
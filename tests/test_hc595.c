@@ -0,0 +1,88 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// HC595 column driver (hc595_matrix.h), against a model of the shift register
+// chain on the stub pins. Built once per chain configuration (Makefile): chain
+// length, bit order, bit offset and polarity come from the HC595_* defines.
+
+#include "test.h"
+#include "hc595_chain.h"
+
+static void reset(void) {
+    memset(host_pin_level, 0, sizeof(host_pin_level));
+    memset(host_pin_output, 0, sizeof(host_pin_output));
+    chain_reset();
+    hc595_init();
+}
+
+// ============================== CHECKS ======================================
+
+static void check_init(void) {
+    reset();
+    CHECK(host_pin_output[HC595_DS_PIN] && host_pin_output[HC595_SHCP_PIN] && host_pin_output[HC595_STCP_PIN], "control pins not outputs");
+    CHECK(chain_shift_edges == 0 && chain_latch_edges == 0, "init clocked the chain");
+}
+
+static void check_columns(void) {
+    reset();
+
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (HC595_IS_GPIO_COL(col)) {
+            CHECK(col < HC595_GPIO_COLS, "column %u: GPIO column past HC595_GPIO_COLS", col);
+            continue;
+        }
+
+        uint32_t shift_edges = chain_shift_edges;
+        uint32_t latch_edges = chain_latch_edges;
+        hc595_write(hc595_col_data(col));
+
+        CHECK(chain_shift_edges - shift_edges == HC595_BITS, "column %u: %u shift clocks, expected %u", col, chain_shift_edges - shift_edges, HC595_BITS);
+        CHECK(chain_latch_edges - latch_edges == 1, "column %u: %u latch clocks", col, chain_latch_edges - latch_edges);
+        CHECK(chain_selected_outputs() == (uint32_t)1 << chain_column_output(col), "column %u: selected outputs 0x%08X, expected output %u", col, chain_selected_outputs(), chain_column_output(col));
+        CHECK(host_pin_level[HC595_STCP_PIN] && host_pin_level[HC595_SHCP_PIN], "column %u: clocks not left high", col);
+    }
+    CHECK(!chain_outputs_changed_early, "outputs latched before the whole chain was shifted");
+
+    // Every shift-register column on its own output, within the chain
+    uint32_t used = 0;
+    for (uint8_t col = HC595_GPIO_COLS; col < MATRIX_COLS; col++) {
+        CHECK(chain_column_output(col) < HC595_BITS, "column %u on output %u, past the chain", col, chain_column_output(col));
+        CHECK(!(used & ((uint32_t)1 << chain_column_output(col))), "column %u shares output %u", col, chain_column_output(col));
+        used |= (uint32_t)1 << chain_column_output(col);
+    }
+}
+
+static void check_none_all(void) {
+    reset();
+
+    hc595_write(HC595_NONE);
+    CHECK(chain_selected_outputs() == 0, "HC595_NONE selects outputs 0x%08X", chain_selected_outputs());
+
+    hc595_write(HC595_ALL);
+    uint32_t all = (uint32_t)(hc595_data_t)~(hc595_data_t)0;
+    CHECK(chain_selected_outputs() == all, "HC595_ALL selects outputs 0x%08X", chain_selected_outputs());
+
+    // Parking keeps the latched outputs
+    hc595_park();
+    CHECK(!host_pin_level[HC595_DS_PIN] && !host_pin_level[HC595_SHCP_PIN] && !host_pin_level[HC595_STCP_PIN], "control pins not parked low");
+    CHECK(chain_selected_outputs() == all, "parking changed the outputs to 0x%08X", chain_selected_outputs());
+
+    // Writing after parking: the first shift clock is a rising edge
+    hc595_write(hc595_col_data(MATRIX_COLS - 1));
+    CHECK(chain_selected_outputs() == (uint32_t)1 << chain_column_output(MATRIX_COLS - 1), "after parking: selected outputs 0x%08X", chain_selected_outputs());
+}
+
+int main(void) {
+    check_init();
+    check_columns();
+    check_none_all();
+
+    char name[64];
+#ifdef HC595_LSB_FIRST
+    const char *order = "LSB";
+#else
+    const char *order = "MSB";
+#endif
+    snprintf(name, sizeof(name), "hc595 (%u x 8, %s first, offset %u, %u GPIO)", HC595_COUNT, order, HC595_BIT_OFFSET, HC595_GPIO_COLS);
+    return test_summary(name);
+}
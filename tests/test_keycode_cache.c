@@ -0,0 +1,153 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Resolved keycode cache (keycode_cache.c) on the code1 keymap: for every
+// combination of the keymap's layers and both default layers (DIP switch),
+// every position reads the keycode QMK's layer walk gives from the dense
+// keymaps[], from the cache and through the cached keymap_key_to_keycode()
+// (key events), which gives the keymap's keycode on every layer, and the
+// highest layer is the highest active one. A random run changes the layers
+// and the default layer between reads and key events, so a stale cache is
+// found, and a release is resolved on the layer of its press, as QMK's
+// source layer cache does. The KCCH dump reports no mismatch.
+
+#include <stdarg.h>
+#include <stdlib.h>
+
+#include "test.h"
+#include "host_stubs.h"
+#include "keycode_cache.h"
+
+// Layers of the code1 keymap (enum kkb_layers in keymap.c)
+#define LAYERS 10
+
+static const layer_state_t default_layers[] = {(layer_state_t)1 << 0, (layer_state_t)1 << 1};
+
+// Instrumentation from the keyboard (stall_watch.c), not under test
+void kkb_stall_enter(uint8_t section) {
+    (void)section;
+}
+
+void kkb_stall_leave(void) {}
+
+// As QMK's layer_switch_get_layer() and keymap_key_to_keycode(), on keymaps[]: layer 0 when all are KC_TRNS
+static uint16_t qmk_keycode(uint8_t row, uint8_t col) {
+    layer_state_t layers = layer_state | default_layer_state;
+    for (int8_t layer = 31; layer >= 0; layer--) {
+        if (layers & ((layer_state_t)1 << layer)) {
+            uint16_t keycode = keycode_at_keymap_location_raw(layer, row, col);
+            if (keycode != KC_TRNS) {
+                return keycode;
+            }
+        }
+    }
+    return keycode_at_keymap_location_raw(0, row, col);
+}
+
+static void check_matrix(void) {
+    layer_state_t layers = layer_state | default_layer_state;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            keypos_t key    = {.row = row, .col = col};
+            uint16_t cached = kkb_keycode_cache_get(row, col);
+            uint16_t event  = keymap_key_to_keycode(layer_switch_get_layer(key), key);
+            CHECK(cached == qmk_keycode(row, col), "layers 0x%03X [%u,%u]: cached 0x%04X, keymap 0x%04X", layers, row, col, cached, qmk_keycode(row, col));
+            CHECK(event == qmk_keycode(row, col), "layers 0x%03X [%u,%u]: key event 0x%04X, keymap 0x%04X", layers, row, col, event, qmk_keycode(row, col));
+            for (uint8_t layer = 0; layer < LAYERS; layer++) {
+                uint16_t keycode = keymap_key_to_keycode(layer, key);
+                CHECK(keycode == keycode_at_keymap_location_raw(layer, row, col), "layers 0x%03X [%u,%u] layer %u: 0x%04X, keymap 0x%04X", layers, row, col, layer, keycode, keycode_at_keymap_location_raw(layer, row, col));
+            }
+        }
+    }
+    CHECK(kkb_keycode_cache_highest() == get_highest_layer(layers), "layers 0x%03X: highest %u", layers, kkb_keycode_cache_highest());
+}
+
+// ============================== CHECKS ======================================
+
+// Every layer state with each default layer
+static void check_all_states(void) {
+    for (uint8_t d = 0; d < sizeof(default_layers) / sizeof(default_layers[0]); d++) {
+        default_layer_set(default_layers[d]);
+        for (layer_state_t state = 0; state < ((layer_state_t)1 << LAYERS); state++) {
+            layer_state = state;
+            check_matrix();
+        }
+    }
+}
+
+// Layer keys and DIP switch flips between reads and key events, as key events and frames interleave
+static void check_random(void) {
+    static int8_t   press_layers[MATRIX_ROWS][MATRIX_COLS]; // Layer of the press (QMK's source layer cache), -1 when released
+    static uint16_t press_keycodes[MATRIX_ROWS][MATRIX_COLS];
+    memset(press_layers, -1, sizeof(press_layers));
+    srand(1);
+    layer_state = 0;
+
+    for (uint32_t step = 0; step < 20000; step++) {
+        uint8_t  row = rand() % MATRIX_ROWS, col = rand() % MATRIX_COLS;
+        keypos_t key = {.row = row, .col = col};
+        if (press_layers[row][col] < 0) {
+            // Press: resolved through the layer walk
+            press_layers[row][col]   = layer_switch_get_layer(key);
+            press_keycodes[row][col] = keymap_key_to_keycode(press_layers[row][col], key);
+            CHECK(press_keycodes[row][col] == qmk_keycode(row, col), "step %u: layers 0x%03X [%u,%u] pressed as 0x%04X, keymap 0x%04X", step, layer_state | default_layer_state, row, col, press_keycodes[row][col], qmk_keycode(row, col));
+        } else {
+            // Release: on the layer of the press, whatever the layers are now
+            uint16_t keycode = keymap_key_to_keycode(press_layers[row][col], key);
+            CHECK(keycode == press_keycodes[row][col], "step %u: layers 0x%03X [%u,%u] released as 0x%04X, pressed as 0x%04X on layer %d", step, layer_state | default_layer_state, row, col, keycode, press_keycodes[row][col], press_layers[row][col]);
+            press_layers[row][col] = -1;
+        }
+
+        switch (rand() % 4) {
+            case 0:
+                layer_on(rand() % LAYERS);
+                break;
+            case 1:
+                layer_off(rand() % LAYERS);
+                break;
+            case 2:
+                default_layer_set(default_layers[rand() % 2]);
+                break;
+            default:
+                break;
+        }
+        row = rand() % MATRIX_ROWS, col = rand() % MATRIX_COLS;
+        CHECK(kkb_keycode_cache_get(row, col) == qmk_keycode(row, col), "step %u: layers 0x%03X [%u,%u] stale", step, layer_state | default_layer_state, row, col);
+        if (step % 64 == 0) {
+            check_matrix();
+        }
+    }
+}
+
+// KCCH line: the walk through the keymap layers against both cached paths, mismatches last
+static char dump_line[128];
+
+int host_printf(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(dump_line, sizeof(dump_line), format, args);
+    va_end(args);
+    return 0;
+}
+
+static void check_dump(void) {
+    for (uint8_t d = 0; d < sizeof(default_layers) / sizeof(default_layers[0]); d++) {
+        default_layer_set(default_layers[d]);
+        for (layer_state_t state = 0; state < ((layer_state_t)1 << LAYERS); state += 7) {
+            layer_state = state;
+            kkb_keycode_cache_dump();
+
+            unsigned long rebuilds, avg, max, uncached, event, frame;
+            unsigned      mismatches;
+            CHECK(sscanf(dump_line, "KCCH %lu %lu %lu %lu %lu %lu %u", &rebuilds, &avg, &max, &uncached, &event, &frame, &mismatches) == 7, "cannot parse '%s'", dump_line);
+            CHECK(mismatches == 0, "layers 0x%03X: %u mismatches with the keymap", layer_state | default_layer_state, mismatches);
+        }
+    }
+}
+
+int main(void) {
+    check_all_states();
+    check_random();
+    check_dump();
+    return test_summary("keycode_cache");
+}
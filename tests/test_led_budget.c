@@ -0,0 +1,129 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// LED current budget (led_budget.h) with the code1 current tune (M_TV 0x38):
+// a frame under budget is sent as rendered, a frame over budget is scaled
+// within it, and no PWM value is ever raised. Frames are the PWM registers
+// of both drivers as rgb_flush.c sends them, the LED channels first.
+
+#include <stdlib.h>
+
+#include "test.h"
+#include "led_budget.h"
+
+#define PWM_REGISTER_COUNT 192
+#define LED_CHANNELS (RGB_MATRIX_LED_COUNT * 3)
+
+typedef uint8_t pwm_frame_t[DRIVER_COUNT][PWM_REGISTER_COUNT];
+
+static uint8_t *frame_pwm(pwm_frame_t *frame) {
+    return &(*frame)[0][0];
+}
+
+static uint32_t frame_total(pwm_frame_t *frame) {
+    uint32_t total = 0;
+    for (uint16_t i = 0; i < sizeof(pwm_frame_t); i++) {
+        total += frame_pwm(frame)[i];
+    }
+    return total;
+}
+
+// As budget_limit() in rgb_flush.c: the factor of the frame's sum, the frame scaled when under 256
+static uint16_t limit(pwm_frame_t *frame) {
+    uint16_t factor = kkb_led_budget_factor(frame_total(frame));
+    if (factor < 256) {
+        kkb_led_budget_scale(frame_pwm(frame), sizeof(pwm_frame_t), factor);
+    }
+    return factor;
+}
+
+// Every LED channel at a value, or random values up to a maximum
+static void fill(pwm_frame_t *frame, uint8_t value, bool random) {
+    memset(frame, 0, sizeof(pwm_frame_t));
+    for (uint16_t i = 0; i < LED_CHANNELS; i++) {
+        frame_pwm(frame)[i] = random ? rand() % (value + 1) : value;
+    }
+}
+
+// Limit a frame: within budget, no value raised, and dimmed no more than the rounding needs
+static void check_frame(pwm_frame_t *frame, const char *name) {
+    pwm_frame_t rendered;
+    memcpy(rendered, frame, sizeof(pwm_frame_t));
+    uint32_t total  = frame_total(frame);
+    uint16_t factor = limit(frame);
+
+    if (total <= KKB_LED_BUDGET_PWM) {
+        CHECK(factor == 256 && memcmp(rendered, frame, sizeof(pwm_frame_t)) == 0, "%s: sum %u under budget changed (factor %u)", name, total, factor);
+        return;
+    }
+
+    uint32_t limited = frame_total(frame);
+    CHECK(limited <= KKB_LED_BUDGET_PWM, "%s: sum %u scaled to %u, over the budget of %lu", name, total, limited, (unsigned long)KKB_LED_BUDGET_PWM);
+    CHECK(limited + total / 256 + LED_CHANNELS >= KKB_LED_BUDGET_PWM, "%s: sum %u scaled to %u, dimmed more than the budget needs", name, total, limited);
+    for (uint16_t i = 0; i < sizeof(pwm_frame_t); i++) {
+        CHECK(frame_pwm(frame)[i] <= frame_pwm(&rendered)[i], "%s: channel %u raised from %u to %u", name, i, frame_pwm(&rendered)[i], frame_pwm(frame)[i]);
+    }
+}
+
+// ============================== CHECKS ======================================
+
+static void check_config(void) {
+    CHECK(M_TV == 0x38, "current tune 0x%02X, the code1 keymap uses 0x38", M_TV);
+    CHECK(KKB_LED_CHANNEL_UA == 8750, "channel full scale %lu uA, expected 8750", (unsigned long)KKB_LED_CHANNEL_UA);
+    CHECK(KKB_LED_PWM_TO_MA(KKB_LED_BUDGET_PWM) <= KKB_LED_BUDGET_MA && KKB_LED_PWM_TO_MA(KKB_LED_BUDGET_PWM) + 1 >= KKB_LED_BUDGET_MA, "budget of %lu PWM is %lu mA, expected %u", (unsigned long)KKB_LED_BUDGET_PWM, (unsigned long)KKB_LED_PWM_TO_MA(KKB_LED_BUDGET_PWM), KKB_LED_BUDGET_MA);
+}
+
+// Every sum: 256 up to the budget, then within it and never raising
+static void check_factor(void) {
+    for (uint32_t total = 0; total <= 255UL * sizeof(pwm_frame_t); total++) {
+        uint16_t factor = kkb_led_budget_factor(total);
+        if (total <= KKB_LED_BUDGET_PWM) {
+            CHECK(factor == 256, "sum %u under budget: factor %u", total, factor);
+        } else {
+            CHECK(factor < 256 && (uint64_t)total * factor / 256 <= KKB_LED_BUDGET_PWM, "sum %u: factor %u over budget", total, factor);
+        }
+    }
+}
+
+// Every value and factor: never raised
+static void check_scale(void) {
+    for (uint16_t factor = 0; factor <= 256; factor++) {
+        for (uint16_t value = 0; value < 256; value++) {
+            uint8_t pwm = value;
+            kkb_led_budget_scale(&pwm, 1, factor);
+            CHECK(pwm <= value, "%u scaled by %u/256 raised to %u", value, factor, pwm);
+            CHECK(factor < 256 || pwm == value, "%u scaled by 256/256 changed to %u", value, pwm);
+        }
+    }
+}
+
+static void check_frames(void) {
+    static pwm_frame_t frame;
+
+    // Full white at M_TV 0x38: about 1.8 A estimated, sent within the budget
+    fill(&frame, 255, false);
+    CHECK(KKB_LED_PWM_TO_MA(frame_total(&frame)) > KKB_LED_BUDGET_MA, "full white estimated at %lu mA, under the budget", (unsigned long)KKB_LED_PWM_TO_MA(frame_total(&frame)));
+    check_frame(&frame, "full white");
+    CHECK(KKB_LED_PWM_TO_MA(frame_total(&frame)) <= KKB_LED_BUDGET_MA, "full white sent at %lu mA", (unsigned long)KKB_LED_PWM_TO_MA(frame_total(&frame)));
+
+    // Uniform frames at every level, through the budget
+    for (uint16_t value = 0; value < 256; value++) {
+        fill(&frame, value, false);
+        check_frame(&frame, "uniform");
+    }
+
+    // Random frames of every brightness
+    srand(1);
+    for (uint16_t i = 0; i < 20000; i++) {
+        fill(&frame, rand() % 256, true);
+        check_frame(&frame, "random");
+    }
+}
+
+int main(void) {
+    check_config();
+    check_factor();
+    check_scale();
+    check_frames();
+    return test_summary("led_budget");
+}
@@ -0,0 +1,232 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Matrix scan (matrix.c) on a model of the key matrix: a row reads low when a
+// pressed key is on a driven column (GPIO column low, or HC595 output low
+// through hc595_chain.h), and rows may only be read once the columns have
+// settled (wait_us() after the last change). Checks that the idle probe
+// (matrix_scan_idle(), matrix_rows_idle()) and the wake mode never miss a
+// press: after every scan the raw matrix is the set of pressed keys.
+
+#include <stdlib.h>
+
+#include "test.h"
+#include "hc595_chain.h"
+#include "matrix.h"
+#include "usb_suspend.h"
+#include "boot_profile.h"
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+// Keys held down, and the matrix as scanned
+static matrix_row_t pressed[MATRIX_ROWS];
+static matrix_row_t raw[MATRIX_ROWS];
+
+// Columns driven when the last wait_us() ended, and settle waits per scan
+static uint16_t settled_cols;
+static uint16_t scan_waits;
+static uint32_t unsettled_reads;
+
+// Boot profile and wake edge (usb_suspend.c), not under test
+uint16_t kkb_boot_marked = 0xFFFF;
+
+void kkb_boot_mark_slow(uint8_t milestone) {
+    (void)milestone;
+}
+
+void kkb_suspend_wake_edge(void) {}
+
+// ============================== KEY MATRIX ==================================
+
+static uint16_t driven_cols(void) {
+    uint16_t cols = 0;
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        bool driven;
+        if (HC595_IS_GPIO_COL(col)) {
+            driven = col_pins[col] != NO_PIN && host_pin_output[col_pins[col]] && !host_pin_level[col_pins[col]];
+        } else {
+            driven = chain_selected_outputs() & ((uint32_t)1 << chain_column_output(col));
+        }
+        cols |= (uint16_t)driven << col;
+    }
+    return cols;
+}
+
+void wait_us(uint32_t us) {
+    (void)us;
+    settled_cols = driven_cols();
+    scan_waits++;
+}
+
+uint8_t gpio_read_pin(pin_t pin) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (pin == row_pins[row] && !host_pin_output[pin]) {
+            uint16_t cols = driven_cols();
+            if (cols != settled_cols) {
+                unsettled_reads++;
+            }
+            return !(pressed[row] & cols);
+        }
+    }
+    return host_pin_level[pin];
+}
+
+// ============================== SCANS =======================================
+
+static void reset(void) {
+    memset(host_pin_level, 0, sizeof(host_pin_level));
+    memset(host_pin_output, 0, sizeof(host_pin_output));
+    memset(pressed, 0, sizeof(pressed));
+    memset(raw, 0, sizeof(raw));
+    chain_reset();
+    unsettled_reads = 0;
+    matrix_init_custom();
+}
+
+static void set_key(uint8_t row, uint8_t col, bool down) {
+    if (down) {
+        pressed[row] |= MATRIX_ROW_SHIFTER << col;
+    } else {
+        pressed[row] &= ~(MATRIX_ROW_SHIFTER << col);
+    }
+}
+
+// One scan, 1 ms after the last one (the columns have settled): the change
+// it reports, and the raw matrix must be the pressed keys
+static bool scan(void) {
+    matrix_row_t before[MATRIX_ROWS];
+    memcpy(before, raw, sizeof(raw));
+
+    settled_cols = driven_cols();
+    scan_waits   = 0;
+    bool changed = matrix_scan_custom(raw);
+
+    CHECK(memcmp(raw, pressed, sizeof(raw)) == 0, "raw matrix is not the pressed keys");
+    CHECK(changed == (memcmp(raw, before, sizeof(raw)) != 0), "change %sreported", changed ? "" : "not ");
+    return changed;
+}
+
+static bool any_pressed(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (pressed[row]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================== CHECKS ======================================
+
+static void check_init(void) {
+    reset();
+    CHECK(driven_cols() == 0, "columns 0x%04X driven after init", driven_cols());
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        CHECK(!host_pin_output[row_pins[row]] && host_pin_level[row_pins[row]], "row %u not an input with pull-up", row);
+    }
+}
+
+// Every key alone from idle: found by the probe, then scanned in full while held
+static void check_single_keys(void) {
+    reset();
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            CHECK(!scan() && scan_waits == 1, "idle scan: %u settle waits, expected 1 (probe)", scan_waits);
+
+            set_key(row, col, true);
+            CHECK(scan(), "[%u,%u] press not reported", row, col);
+            CHECK(scan_waits == 1 + MATRIX_COLS, "[%u,%u] press: %u settle waits, expected probe and full scan", row, col, scan_waits);
+            CHECK(!scan() && scan_waits == MATRIX_COLS, "[%u,%u] held: %u settle waits, expected a full scan", row, col, scan_waits);
+
+            set_key(row, col, false);
+            CHECK(scan(), "[%u,%u] release not reported", row, col);
+            CHECK(driven_cols() == 0, "[%u,%u] columns 0x%04X left driven", row, col, driven_cols());
+        }
+    }
+    CHECK(unsettled_reads == 0, "%u rows read before the columns settled", unsettled_reads);
+}
+
+// Every pair of keys pressed between the same two scans
+static void check_key_pairs(void) {
+    reset();
+
+    for (uint8_t a = 0; a < MATRIX_ROWS * MATRIX_COLS; a++) {
+        for (uint8_t b = a + 1; b < MATRIX_ROWS * MATRIX_COLS; b++) {
+            set_key(a / MATRIX_COLS, a % MATRIX_COLS, true);
+            set_key(b / MATRIX_COLS, b % MATRIX_COLS, true);
+            CHECK(scan(), "keys %u and %u not reported", a, b);
+            set_key(a / MATRIX_COLS, a % MATRIX_COLS, false);
+            set_key(b / MATRIX_COLS, b % MATRIX_COLS, false);
+            scan();
+        }
+    }
+    CHECK(unsettled_reads == 0, "%u rows read before the columns settled", unsettled_reads);
+}
+
+// Random presses and releases between scans, idle stretches in between
+static void check_random(void) {
+    srand(1);
+    reset();
+
+    uint32_t probes = 0;
+    for (uint32_t step = 0; step < 200000; step++) {
+        uint8_t changes = rand() % 4;
+        for (uint8_t i = 0; i < changes; i++) {
+            set_key(rand() % MATRIX_ROWS, rand() % MATRIX_COLS, rand() % 3 != 0);
+        }
+        if (rand() % 8 == 0) {
+            memset(pressed, 0, sizeof(pressed));
+        }
+
+        bool idle_before = !any_pressed();
+        scan();
+        probes += idle_before && scan_waits == 1;
+    }
+    CHECK(probes > 10000, "only %u idle probes in the random run", probes);
+    CHECK(unsettled_reads == 0, "%u rows read before the columns settled", unsettled_reads);
+}
+
+// Wake mode: all columns driven between scans, any press is found
+static void check_wake_mode(void) {
+    reset();
+
+    matrix_suspend_kkb();
+    CHECK(driven_cols() == (uint16_t)((1UL << MATRIX_COLS) - 1), "suspended: columns 0x%04X driven", driven_cols());
+    CHECK(!host_pin_level[HC595_DS_PIN] && !host_pin_level[HC595_SHCP_PIN] && !host_pin_level[HC595_STCP_PIN], "suspended: HC595 pins not parked low");
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            CHECK(!scan() && scan_waits == 0, "suspended idle scan: %u settle waits", scan_waits);
+
+            set_key(row, col, true);
+            CHECK(scan(), "suspended: [%u,%u] press not reported", row, col);
+            scan();
+            set_key(row, col, false);
+            CHECK(scan(), "suspended: [%u,%u] release not reported", row, col);
+
+            CHECK(driven_cols() == (uint16_t)((1UL << MATRIX_COLS) - 1), "suspended: columns 0x%04X driven after a scan", driven_cols());
+            CHECK(!host_pin_level[HC595_SHCP_PIN] && !host_pin_level[HC595_STCP_PIN], "suspended: HC595 pins not parked after a scan");
+        }
+    }
+
+    // Held through the resume
+    set_key(2, 5, true);
+    scan();
+    matrix_resume_kkb();
+    CHECK(driven_cols() == 0, "resumed: columns 0x%04X driven", driven_cols());
+    CHECK(!scan(), "resumed: held key reported again");
+    set_key(2, 5, false);
+    CHECK(scan(), "resumed: release not reported");
+    CHECK(!scan() && scan_waits == 1, "resumed: idle scan not a probe");
+    CHECK(unsettled_reads == 0, "%u rows read before the columns settled", unsettled_reads);
+}
+
+int main(void) {
+    check_init();
+    check_single_keys();
+    check_key_pairs();
+    check_random();
+    check_wake_mode();
+    return test_summary("matrix");
+}
@@ -0,0 +1,251 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Reactive key heat (reactive_heat.c) and the KKB_REACTIVE effect
+// (rgb_matrix_kb.inc): heat on press, linear decay, blending. With --bench:
+// time per key press and per frame, next to QMK's typing_heatmap and
+// solid_reactive_simple (qmk/rgb_matrix_effects.c).
+
+#include "test.h"
+#include "host_stubs.h"
+#include "rgb_matrix_effects.h"
+#include "reactive_heat.h"
+
+#define RGB_MATRIX_EFFECT(name)
+#define RGB_MATRIX_CUSTOM_EFFECT_IMPLS
+#include "rgb_matrix_kb.inc"
+
+// Matrix position of each LED
+static keypos_t led_position[RGB_MATRIX_LED_COUNT];
+
+// All keys cold at start_ms: decay calls return without work, the next press restarts the clock
+static void reset(uint32_t start_ms) {
+    host_timer_ms = start_ms - 2 * KKB_REACTIVE_DECAY_MS;
+    kkb_reactive_key_event(0, 0, true);
+    kkb_reactive_decay();
+    host_timer_ms = start_ms;
+    kkb_reactive_decay();
+}
+
+static void press(uint8_t led) {
+    kkb_reactive_key_event(led_position[led].row, led_position[led].col, true);
+    kkb_reactive_key_event(led_position[led].row, led_position[led].col, false);
+}
+
+// All iterations of a frame, as rgb_matrix_task() over RGB_MATRIX_LED_PROCESS_LIMIT chunks
+static void render_frame(bool (*effect)(effect_params_t *)) {
+    effect_params_t params = {.flags = LED_FLAG_ALL};
+    while (effect(&params)) {
+        params.iter++;
+    }
+}
+
+static void check_press(void) {
+    reset(1000);
+
+    press(10);
+    CHECK(kkb_reactive_heat(10) == KKB_REACTIVE_HIT, "pressed LED heat %u, expected %u", kkb_reactive_heat(10), KKB_REACTIVE_HIT);
+    for (uint8_t led = 0; led < RGB_MATRIX_LED_COUNT; led++) {
+        if (led != 10) {
+            CHECK(kkb_reactive_heat(led) == 0, "LED %u heated by a press of LED 10", led);
+        }
+    }
+
+    // Releases, positions without an LED and outside the matrix do nothing
+    uint8_t before[RGB_MATRIX_LED_COUNT];
+    memcpy(before, g_kkb_reactive_heat, sizeof(before));
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            kkb_reactive_key_event(row, col, false);
+            if (g_led_config.matrix_co[row][col] == NO_LED) {
+                kkb_reactive_key_event(row, col, true);
+            }
+        }
+    }
+    kkb_reactive_key_event(MATRIX_ROWS, 0, true);
+    kkb_reactive_key_event(0, MATRIX_COLS, true);
+    CHECK(memcmp(before, g_kkb_reactive_heat, sizeof(before)) == 0, "heat changed by a release or a key without an LED");
+}
+
+static void check_decay(void) {
+    // Decayed every ms, from full heat to zero in KKB_REACTIVE_DECAY_MS (rounded down steps: a few ms more)
+    reset(2000);
+    press(0);
+    uint16_t ms = 0;
+    while (kkb_reactive_heat(0) != 0 && ms < 2 * KKB_REACTIVE_DECAY_MS) {
+        uint8_t heat = kkb_reactive_heat(0);
+        host_timer_ms++;
+        ms++;
+        kkb_reactive_decay();
+        CHECK(kkb_reactive_heat(0) <= heat, "heat rose from %u to %u", heat, kkb_reactive_heat(0));
+        if (ms == KKB_REACTIVE_DECAY_MS / 2) {
+            CHECK(kkb_reactive_heat(0) >= 125 && kkb_reactive_heat(0) <= 130, "heat %u at half the decay time", kkb_reactive_heat(0));
+        }
+    }
+    CHECK(ms >= KKB_REACTIVE_DECAY_MS && ms <= KKB_REACTIVE_DECAY_MS + 10, "cold after %u ms, expected %u", ms, KKB_REACTIVE_DECAY_MS);
+
+    // Decayed once per frame: the remainder is kept, same heat as every ms
+    static const uint8_t frame_ms[] = {1, 7, 16, 33};
+    for (uint8_t i = 0; i < sizeof(frame_ms); i++) {
+        reset(3000);
+        press(0);
+        for (uint16_t t = 0; t < KKB_REACTIVE_DECAY_MS / 2; t += frame_ms[i]) {
+            host_timer_ms += frame_ms[i];
+            kkb_reactive_decay();
+        }
+        uint16_t elapsed  = (KKB_REACTIVE_DECAY_MS / 2 + frame_ms[i] - 1) / frame_ms[i] * frame_ms[i];
+        uint16_t expected = 255 - elapsed * ((255UL << 8) / KKB_REACTIVE_DECAY_MS) / 256;
+        CHECK(kkb_reactive_heat(0) == expected, "frames of %u ms: heat %u after %u ms, expected %u", frame_ms[i], kkb_reactive_heat(0), elapsed, expected);
+    }
+
+    // A press after a long idle time decays from the press, not from the last decay call
+    reset(4000);
+    host_timer_ms += 10000;
+    press(5);
+    host_timer_ms += 1;
+    kkb_reactive_decay();
+    CHECK(kkb_reactive_heat(5) >= 254, "heat %u 1 ms after a press following idle time", kkb_reactive_heat(5));
+
+    // A long frame gap cools everything at once
+    host_timer_ms += 60000;
+    kkb_reactive_decay();
+    CHECK(kkb_reactive_heat(5) == 0, "heat %u after 60 s", kkb_reactive_heat(5));
+}
+
+static void check_blend(void) {
+    for (uint16_t from = 0; from <= 255; from++) {
+        for (uint16_t to = 0; to <= 255; to++) {
+            CHECK(kkb_reactive_blend(from, to, 0) == from, "blend(%u, %u, 0) = %u", from, to, kkb_reactive_blend(from, to, 0));
+            CHECK(kkb_reactive_blend(from, to, 255) == to, "blend(%u, %u, 255) = %u", from, to, kkb_reactive_blend(from, to, 255));
+            uint8_t half = kkb_reactive_blend(from, to, 128);
+            CHECK(half >= MIN(from, to) && half <= MAX(from, to), "blend(%u, %u, 128) = %u", from, to, half);
+        }
+    }
+}
+
+static void check_effect(void) {
+    reset(5000);
+    press(20);
+
+    host_led_calls = 0;
+    memset(host_leds, 0, sizeof(host_leds));
+    render_frame(KKB_REACTIVE);
+    CHECK(host_led_calls == RGB_MATRIX_LED_COUNT, "effect set %u LEDs, expected %u", host_led_calls, RGB_MATRIX_LED_COUNT);
+
+    // Cold LEDs at half brightness of the configured color, the pressed one brighter and hue shifted
+    hsv_t cold_hsv = rgb_matrix_config.hsv;
+    cold_hsv.v     = scale8(cold_hsv.v, 128);
+    rgb_t cold     = hsv_to_rgb(cold_hsv);
+    CHECK(memcmp(&host_leds[0], &cold, sizeof(cold)) == 0, "cold LED %u,%u,%u, expected %u,%u,%u", host_leds[0].r, host_leds[0].g, host_leds[0].b, cold.r, cold.g, cold.b);
+    CHECK(memcmp(&host_leds[20], &cold, sizeof(cold)) != 0, "pressed LED at the cold color");
+}
+
+// ============================== BENCHMARK ===================================
+
+#define BENCH_FRAME_MS 16
+#define BENCH_PRESS_FRAMES 6 // A press every 96 ms, about 10 per second
+
+typedef struct {
+    const char *name;
+    void (*press)(uint8_t led);
+    void (*frame)(void);
+    uint16_t ram;
+} bench_effect_t;
+
+static void kkb_reactive_press(uint8_t led) {
+    kkb_reactive_key_event(led_position[led].row, led_position[led].col, true);
+}
+
+static void kkb_reactive_frame(void) {
+    render_frame(KKB_REACTIVE);
+}
+
+static void typing_heatmap_press(uint8_t led) {
+    process_rgb_matrix_typing_heatmap(led_position[led].row, led_position[led].col);
+}
+
+static void typing_heatmap_frame(void) {
+    render_frame(TYPING_HEATMAP);
+}
+
+static void solid_reactive_press(uint8_t led) {
+    process_rgb_matrix_hits(led_position[led].row, led_position[led].col, true);
+}
+
+static void solid_reactive_frame(void) {
+    rgb_matrix_hit_ticks(BENCH_FRAME_MS);
+    render_frame(SOLID_REACTIVE_SIMPLE);
+}
+
+// Heat and state (reactive_heat.c), frame buffer and timer state, hit tracker
+static const bench_effect_t bench_effects[] = {
+    {"kkb_reactive", kkb_reactive_press, kkb_reactive_frame, RGB_MATRIX_LED_COUNT + 5},
+    {"typing_heatmap", typing_heatmap_press, typing_heatmap_frame, sizeof(g_rgb_frame_buffer) + 3},
+    {"solid_reactive_simple", solid_reactive_press, solid_reactive_frame, sizeof(last_hit_t)},
+};
+
+static void run_bench(void) {
+    static const uint32_t presses = 100000;
+    static const uint32_t frames  = 20000;
+
+    printf("%-22s %6s %10s %14s %14s\n", "effect", "RAM", "ns/press", "ns/frame typ.", "ns/frame idle");
+    for (uint8_t e = 0; e < sizeof(bench_effects) / sizeof(bench_effects[0]); e++) {
+        const bench_effect_t *effect = &bench_effects[e];
+        reset(10000);
+        memset(g_rgb_frame_buffer, 0, sizeof(g_rgb_frame_buffer));
+        memset(&g_last_hit_tracker, 0, sizeof(g_last_hit_tracker));
+
+        uint64_t start = test_now_ns();
+        for (uint32_t i = 0; i < presses; i++) {
+            effect->press((i * 7) % RGB_MATRIX_LED_COUNT);
+        }
+        double press_ns = (double)(test_now_ns() - start) / presses;
+
+        // Typing: frames with a press every BENCH_PRESS_FRAMES, the presses are timed too
+        start = test_now_ns();
+        for (uint32_t frame = 0; frame < frames; frame++) {
+            if (frame % BENCH_PRESS_FRAMES == 0) {
+                effect->press((frame * 7) % RGB_MATRIX_LED_COUNT);
+            }
+            host_timer_ms += BENCH_FRAME_MS;
+            effect->frame();
+        }
+        double typing_ns = (double)(test_now_ns() - start) / frames;
+
+        // Idle: all keys cooled down
+        for (uint32_t frame = 0; frame < 5000; frame++) {
+            host_timer_ms += BENCH_FRAME_MS;
+            effect->frame();
+        }
+        start = test_now_ns();
+        for (uint32_t frame = 0; frame < frames; frame++) {
+            host_timer_ms += BENCH_FRAME_MS;
+            effect->frame();
+        }
+        double idle_ns = (double)(test_now_ns() - start) / frames;
+
+        printf("%-22s %6u %10.0f %14.0f %14.0f\n", effect->name, effect->ram, press_ns, typing_ns, idle_ns);
+    }
+}
+
+int main(int argc, char **argv) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led != NO_LED) {
+                led_position[led] = (keypos_t){.col = col, .row = row};
+            }
+        }
+    }
+
+    if (test_bench_mode(argc, argv)) {
+        run_bench();
+        return 0;
+    }
+
+    check_press();
+    check_decay();
+    check_blend();
+    check_effect();
+    return test_summary("reactive_heat");
+}
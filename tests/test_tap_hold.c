@@ -0,0 +1,228 @@
+// Copyright 2025 kkb (@ktragethon)
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Predictive tap-hold (tap_hold.c) on the code1 keymap: recorded key traces
+// (traces/*.krec, KREC lines as the key recorder prints them) replayed
+// through the keyboard's adaptive debounce (adaptive_debounce.c) and
+// kkb_tap_hold_process(), as QMK calls them. Each trace lists the keys it
+// must send (KEYS) and its decision histograms (TAPH, as KC_DIAG dumps
+// them). tools/keyrec_replay.py gives the same decisions for these traces.
+
+#include "test.h"
+#include "host_stubs.h"
+#include "tap_hold.h"
+#include "debounce.h"
+
+static const char *const traces[] = {
+    "traces/tap_hold_flow.krec",
+    "traces/tap_hold_roll.krec",
+    "traces/tap_hold_caps.krec",
+    "traces/tap_hold_bounce.krec",
+    "traces/tap_hold_term.krec",
+};
+
+// Layers of the code1 keymap (enum kkb_layers in keymap.c)
+#define L_CODE 1
+
+// Scanned after the last record until all debounce windows have ended
+#define TRACE_SETTLE_MS 100
+
+// Traces replayed this far apart, so typing speed does not carry over
+#define TRACE_GAP_MS 10000
+
+static const char *const decision_names[KKB_TH_DECISIONS] = {
+    "tap_flow", "tap_roll", "tap_release", "hold_key", "hold_alone",
+};
+
+// Instrumentation from the keyboard (stall_watch.c), not under test
+void kkb_stall_enter(uint8_t section) {
+    (void)section;
+}
+
+void kkb_stall_leave(void) {}
+
+// ============================== HOST ========================================
+
+// Keys sent to the host: " +04 -04 ..."
+static char keys_sent[1024];
+
+static void key_sent(char action, uint8_t kc) {
+    size_t len = strlen(keys_sent);
+    snprintf(keys_sent + len, sizeof(keys_sent) - len, " %c%02X", action, kc);
+}
+
+void register_code(uint8_t kc) {
+    key_sent('+', kc);
+}
+
+void unregister_code(uint8_t kc) {
+    key_sent('-', kc);
+}
+
+// ============================== QMK =========================================
+
+// Layer each pressed key was resolved on (QMK's source layer cache)
+static uint8_t source_layer[MATRIX_ROWS][MATRIX_COLS];
+
+// Keycode of an event, as get_record_keycode(record, true): a press is
+// resolved on the active layers and cached, a release on the cached layer
+static uint16_t record_keycode(keyrecord_t *record) {
+    keypos_t key = record->event.key;
+    if (record->event.pressed) {
+        source_layer[key.row][key.col] = layer_switch_get_layer(key);
+    }
+    return keymap_key_to_keycode(source_layer[key.row][key.col], key);
+}
+
+// The actions of the keycodes in the traces
+static void process_keycode(uint16_t keycode, bool pressed) {
+    if (IS_QK_MOMENTARY(keycode)) {
+        if (pressed) {
+            layer_on(QK_LAYER_GET(keycode));
+        } else {
+            layer_off(QK_LAYER_GET(keycode));
+        }
+    } else if (IS_BASIC_KEYCODE(keycode) && keycode != KC_NO) {
+        if (pressed) {
+            register_code(keycode);
+        } else {
+            unregister_code(keycode);
+        }
+    }
+}
+
+// A key event through pre_process_record_kb() (the tap-hold part) and QMK,
+// which resolves the keycode again once pre-processing is done
+static void key_event(uint8_t row, uint8_t col, bool pressed) {
+    keyrecord_t record = {.event = {.key = {.col = col, .row = row}, .time = (uint16_t)host_timer_ms, .pressed = pressed}};
+    if (kkb_tap_hold_process(record_keycode(&record), &record)) {
+        process_keycode(record_keycode(&record), pressed);
+    }
+}
+
+// ============================== MATRIX ======================================
+
+// Raw rows as recorded, and as committed by the debounce
+static matrix_row_t raw_rows[MATRIX_ROWS];
+static matrix_row_t cooked_rows[MATRIX_ROWS];
+
+// One scan: debounce, then an event for every committed change, in matrix order (as matrix_task())
+static void scan(bool changed) {
+    matrix_row_t before[MATRIX_ROWS];
+    memcpy(before, cooked_rows, sizeof(before));
+
+    if (!debounce(raw_rows, cooked_rows, MATRIX_ROWS, changed)) {
+        return;
+    }
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t delta = before[row] ^ cooked_rows[row];
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (delta & (MATRIX_ROW_SHIFTER << col)) {
+                key_event(row, col, cooked_rows[row] & (MATRIX_ROW_SHIFTER << col));
+            }
+        }
+    }
+}
+
+// Scan once per ms tick up to a time
+static void scan_until(uint32_t ms) {
+    while (host_timer_ms < ms) {
+        host_timer_ms++;
+        scan(false);
+    }
+}
+
+// ============================== TRACES ======================================
+
+static void replay(const char *path) {
+    FILE *file = fopen(path, "r");
+    CHECK(file != NULL, "%s: cannot open", path);
+    if (file == NULL) {
+        return;
+    }
+
+    uint16_t before[KKB_TH_DECISIONS][KKB_TAP_HOLD_BUCKETS];
+    for (uint8_t decision = 0; decision < KKB_TH_DECISIONS; decision++) {
+        kkb_tap_hold_get_histogram(decision, before[decision]);
+    }
+
+    uint32_t start_ms = host_timer_ms + TRACE_GAP_MS;
+    uint16_t records = 0, expected_records = 0;
+    bool     keys_checked = false;
+    uint8_t  taph_checked = 0;
+    keys_sent[0]          = '\0';
+
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\r\n")] = '\0';
+
+        unsigned cycles, ms, row, state, count, cpu_hz, dropped;
+        char     name[32];
+        unsigned buckets[KKB_TAP_HOLD_BUCKETS];
+
+        if (line[0] == '#' || line[0] == '\0') {
+            continue;
+        } else if (sscanf(line, "KREC BEGIN %u %u %u", &count, &cpu_hz, &dropped) == 3) {
+            CHECK(dropped == 0, "%s: %u records dropped", path, dropped);
+            expected_records = count;
+        } else if (sscanf(line, "KREC %x %x %u %x", &cycles, &ms, &row, &state) == 4) {
+            CHECK(row < MATRIX_ROWS, "%s: row %u", path, row);
+            if (row >= MATRIX_ROWS) {
+                continue;
+            }
+            // Scanned on the record's ms tick, after the scans of the ticks before it
+            scan_until(start_ms + ms);
+            raw_rows[row] = state;
+            scan(true);
+            records++;
+        } else if (strncmp(line, "KEYS", 4) == 0) {
+            scan_until(host_timer_ms + TRACE_SETTLE_MS);
+            CHECK(strcmp(keys_sent, line + 4) == 0, "%s: keys sent%s, expected%s", path, keys_sent, line + 4);
+            keys_checked = true;
+        } else if (sscanf(line, "TAPH %31s %u %u %u %u %u %u", name, &buckets[0], &buckets[1], &buckets[2], &buckets[3], &buckets[4], &buckets[5]) == 7) {
+            uint8_t decision = 0;
+            while (decision < KKB_TH_DECISIONS && strcmp(name, decision_names[decision]) != 0) {
+                decision++;
+            }
+            CHECK(decision < KKB_TH_DECISIONS, "%s: unknown decision %s", path, name);
+            if (decision == KKB_TH_DECISIONS) {
+                continue;
+            }
+            uint16_t after[KKB_TAP_HOLD_BUCKETS];
+            kkb_tap_hold_get_histogram(decision, after);
+            for (uint8_t bucket = 0; bucket < KKB_TAP_HOLD_BUCKETS; bucket++) {
+                uint16_t decided = after[bucket] - before[decision][bucket];
+                CHECK(decided == buckets[bucket], "%s: %s bucket %u: %u decisions, expected %u", path, name, bucket, decided, buckets[bucket]);
+            }
+            taph_checked++;
+        } else {
+            CHECK(false, "%s: cannot parse '%s'", path, line);
+        }
+    }
+    fclose(file);
+
+    CHECK(records == expected_records, "%s: %u records, KREC BEGIN says %u", path, records, expected_records);
+    CHECK(keys_checked && taph_checked == KKB_TH_DECISIONS, "%s: expected keys or decisions missing", path);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        CHECK(cooked_rows[row] == 0, "%s: keys still down on row %u at the end", path, row);
+    }
+    CHECK(layer_state == 0, "%s: layers 0x%08X still on at the end", path, layer_state);
+}
+
+// Console output of the histogram dump, not checked
+int host_printf(const char *format, ...) {
+    (void)format;
+    return 0;
+}
+
+int main(void) {
+    default_layer_state = (layer_state_t)1 << L_CODE;
+    host_timer_ms       = 1000;
+    debounce_init(MATRIX_ROWS);
+
+    for (uint8_t i = 0; i < sizeof(traces) / sizeof(traces[0]); i++) {
+        replay(traces[i]);
+    }
+    kkb_tap_hold_dump_stats();
+    return test_summary("tap_hold");
+}
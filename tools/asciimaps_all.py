@@ -8,8 +8,14 @@ Generate ASCII maps for all keymaps and all layouts.
 Used for batch generation in CI/CD pipelines.
 """
 
+import io
+import os
 import sys
+import time
+import argparse
+import contextlib
 import importlib.util
+from concurrent.futures import ProcessPoolExecutor
 from pathlib import Path
 from datetime import datetime
 
@@ -78,9 +84,10 @@ def discover_keymaps(keyboards_dir):
     return sorted(keymaps, key=lambda x: x['display_name'])
 
 
-def generate_ascii_map(keymap_info, layout_code, output_dir):
+def generate_ascii_map(keymap_info, layout_code, output_dir, backend='regex'):
     """Generate ASCII map for a specific keymap and layout"""
     keymap_path = keymap_info['path']
+    output_stem = f"{keymap_info['keyboard_name']}_{keymap_info['keymap_name']}_{layout_code}"
 
     try:
         # Load layout configuration
@@ -91,9 +98,11 @@ def generate_ascii_map(keymap_info, layout_code, output_dir):
         # Create visualizer
         visualizer = KeymapVisualizer(layout_config)
 
-        # Parse keymap file
+        # Parse keymap file (the 'cpp' backend also writes the resolved keymap as JSON,
+        # and keeps its results in cache/ so unchanged keymaps are not preprocessed again)
+        artifact_path = output_dir / 'json' / f"{output_stem}.json" if backend == 'cpp' else None
         layers_data, layer_order, layer_comments, file_header, layer_enum_mapping = \
-            visualizer.parse_keymap_file(keymap_path)
+            visualizer.parse_keymap_file(keymap_path, backend, artifact_path, output_dir / 'cache')
 
         if not layers_data:
             print(f"  ⚠️  No layers found in {keymap_info['display_name']}")
@@ -105,7 +114,7 @@ def generate_ascii_map(keymap_info, layout_code, output_dir):
         )
 
         # Create output filename
-        output_filename = f"{keymap_info['keyboard_name']}_{keymap_info['keymap_name']}_{layout_code}.txt"
+        output_filename = f"{output_stem}.txt"
         output_path = output_dir / output_filename
 
         # Write output
@@ -120,6 +129,55 @@ def generate_ascii_map(keymap_info, layout_code, output_dir):
         return False
 
 
+def run_job(job):
+    """
+    Run one keymap x layout job and time it.
+
+    Output from generate_ascii_map() is captured, so jobs running in worker
+    processes can be printed in submission order by the parent.
+    """
+    keymap_info, layout_code, output_dir, backend = job
+    buffer = io.StringIO()
+
+    start = time.perf_counter()
+    with contextlib.redirect_stdout(buffer):
+        success = generate_ascii_map(keymap_info, layout_code, output_dir, backend)
+    elapsed = time.perf_counter() - start
+
+    return {
+        'success': success,
+        'filename': f"{keymap_info['keyboard_name']}_{keymap_info['keymap_name']}_{layout_code}.txt",
+        'output': buffer.getvalue().strip(),
+        'elapsed': elapsed
+    }
+
+
+def run_jobs(jobs, workers):
+    """
+    Run all jobs, sequentially or on a process pool.
+
+    Results are always yielded in the order of 'jobs', so the generated files
+    and the index are identical regardless of the number of workers.
+    """
+    if workers <= 1:
+        for job in jobs:
+            yield run_job(job)
+        return
+
+    with ProcessPoolExecutor(max_workers=workers) as executor:
+        yield from executor.map(run_job, jobs)
+
+
+def parse_args(argv=None):
+    """Parse command line arguments"""
+    parser = argparse.ArgumentParser(description="Generate ASCII maps for all keymaps and all layouts")
+    parser.add_argument('-j', '--jobs', type=int, default=1,
+                        help="Number of worker processes (0 = one per CPU, default: 1)")
+    parser.add_argument('-b', '--backend', choices=('regex', 'cpp'), default='regex',
+                        help="Keymap extraction backend (cpp = run the C preprocessor, default: regex)")
+    return parser.parse_args(argv)
+
+
 def create_index_file(output_dir, results):
     """Create an index file listing all generated maps"""
     index_path = output_dir / 'index.md'
@@ -154,7 +212,10 @@ def create_index_file(output_dir, results):
             f.write("\n")
 
 
-def main():
+def main(argv=None):
+    args = parse_args(argv)
+    workers = args.jobs if args.jobs > 0 else (os.cpu_count() or 1)
+
     print("=" * 70)
     print("QMK ASCII Map Batch Generator")
     print("=" * 70)
@@ -208,23 +269,38 @@ def main():
         'files': []
     }
 
-    total = len(keymaps) * len(layouts)
-    current = 0
+    # Build the job list up front, keymap-major as before
+    jobs = [(keymap, layout, output_dir, args.backend) for keymap in keymaps for layout in layouts]
+    total = len(jobs)
 
-    for keymap in keymaps:
-        print(f"Keymap: {keymap['display_name']}")
+    print(f"Running {total} job(s) with {workers} worker(s), backend: {args.backend}")
+    print()
 
-        for layout in layouts:
-            current += 1
-            print(f"  [{current}/{total}] Layout: {layout}...", end=" ")
+    run_start = time.perf_counter()
+    job_time = 0.0
+    current_keymap = None
 
-            if generate_ascii_map(keymap, layout, output_dir):
-                results['success'] += 1
-                results['files'].append(f"{keymap['keyboard_name']}_{keymap['keymap_name']}_{layout}.txt")
-            else:
-                results['failed'] += 1
+    for current, (job, result) in enumerate(zip(jobs, run_jobs(jobs, workers)), start=1):
+        keymap, layout, _, _ = job
 
-        print()
+        if keymap is not current_keymap:
+            if current_keymap is not None:
+                print()
+            print(f"Keymap: {keymap['display_name']}")
+            current_keymap = keymap
+
+        print(f"  [{current}/{total}] Layout: {layout}... ({result['elapsed'] * 1000:.1f} ms)", end=" ")
+        print(result['output'])
+
+        job_time += result['elapsed']
+        if result['success']:
+            results['success'] += 1
+            results['files'].append(result['filename'])
+        else:
+            results['failed'] += 1
+
+    run_time = time.perf_counter() - run_start
+    print()
 
     # Create index file
     print("Creating index file...")
@@ -237,6 +313,11 @@ def main():
     print("=" * 70)
     print(f"Total generated: {results['success']}")
     print(f"Failed: {results['failed']}")
+    print(f"Workers: {workers}")
+    print(f"Job time (sum): {job_time:.3f} s")
+    print(f"Wall time: {run_time:.3f} s")
+    if run_time > 0:
+        print(f"Speedup: {job_time / run_time:.2f}x")
     print(f"Output directory: {output_dir}")
     print()
 
@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 kkb (@ktragethon)
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Burst output report decoder.
+
+Decodes the keyboard reports sent while KC_BRST runs its benchmark (see
+keyboards/kkb/burst_macro.h): the benchmark text typed in burst mode, then
+with send_string(), each followed by Enter. The reports are read live from
+a Linux hidraw device, or from a capture file, and decoded as the host
+does: modifiers first, then the newly pressed keys in increasing usage
+order. For each run, the decoded text is compared with the expected text,
+and the reports, time and characters per second are printed.
+
+Reports: NKRO (report ID 6, as QMK sends on the shared endpoint), 6KRO
+with report ID 1, and 8 byte boot reports. Keys are decoded with the US
+layout (the benchmark text has the same keys in the Norwegian layout).
+
+Capture file: one report per line, "<seconds> <hex bytes>" (as written by
+--save), lines starting with # are ignored.
+
+Usage:
+    python3 ./tools/burst_decode.py --hidraw /dev/hidraw3 --save capture.txt
+    python3 ./tools/burst_decode.py capture.txt
+    python3 ./tools/burst_decode.py capture.txt --expect "hello world"
+"""
+
+import os
+import re
+import sys
+import time
+import argparse
+from pathlib import Path
+
+tools_dir = Path(__file__).resolve().parent
+burst_header = tools_dir.parent / 'keyboards' / 'kkb' / 'burst_macro.h'
+
+REPORT_ID_KEYBOARD = 1
+REPORT_ID_NKRO = 6
+BOOT_REPORT_SIZE = 8
+
+KC_ENTER = 0x28
+MOD_SHIFT = 0x22  # Left or right shift
+MOD_ALTGR = 0x40  # Right alt
+
+# US layout: usage -> (character, shifted character)
+US_KEYS = {usage: (chr(ord('a') + usage - 0x04), chr(ord('A') + usage - 0x04)) for usage in range(0x04, 0x1E)}
+US_KEYS.update({usage: pair for usage, pair in zip(range(0x1E, 0x28), zip('1234567890', '!@#$%^&*()'))})
+US_KEYS.update({
+    0x2B: ('\t', '\t'), 0x2C: (' ', ' '), 0x2D: ('-', '_'), 0x2E: ('=', '+'), 0x2F: ('[', '{'),
+    0x30: (']', '}'), 0x31: ('\\', '|'), 0x33: (';', ':'), 0x34: ("'", '"'), 0x35: ('`', '~'),
+    0x36: (',', '<'), 0x37: ('.', '>'), 0x38: ('/', '?'),
+})
+
+
+def read_bench_text():
+    """KKB_BURST_BENCH_TEXT from burst_macro.h"""
+    match = re.search(r'#\s*define\s+KKB_BURST_BENCH_TEXT\s+"((?:[^"\\]|\\.)*)"', burst_header.read_text(encoding='utf-8'))
+    return match.group(1).encode().decode('unicode_escape') if match else None
+
+
+def parse_report(data):
+    """(modifiers, set of pressed usages) of a keyboard report, None for other reports"""
+    if len(data) == BOOT_REPORT_SIZE:
+        return data[0], {usage for usage in data[2:] if usage}
+    if len(data) >= 2 and data[0] == REPORT_ID_NKRO:
+        return data[1], {i * 8 + bit for i, byte in enumerate(data[2:]) for bit in range(8) if byte & (1 << bit)}
+    if len(data) == BOOT_REPORT_SIZE + 1 and data[0] == REPORT_ID_KEYBOARD:
+        return data[1], {usage for usage in data[3:] if usage}
+    return None
+
+
+def key_text(usage, mods):
+    if usage not in US_KEYS:
+        return f'<0x{usage:02X}>'
+    char = US_KEYS[usage][1 if mods & MOD_SHIFT else 0]
+    return f'<AltGr+{char}>' if mods & MOD_ALTGR else char
+
+
+class Run:
+    """Text typed between two Enter presses"""
+
+    def __init__(self):
+        self.text = ''
+        self.reports = 0
+        self.first = None
+        self.last = None
+
+    def seconds(self):
+        return self.last - self.first if self.first is not None else 0.0
+
+    def cps(self):
+        return len(self.text) / self.seconds() if self.seconds() > 0 else 0.0
+
+
+def decode(reports):
+    """Split the reports into runs ended by Enter, returns (runs, keyboard reports)"""
+    runs = []
+    run = Run()
+    mods = 0
+    keys = set()
+    count = 0
+
+    for timestamp, data in reports:
+        parsed = parse_report(data)
+        if parsed is None:
+            continue
+        count += 1
+        new_mods, new_keys = parsed
+        pressed = sorted(new_keys - keys)  # The host reads the keys in usage order
+
+        if KC_ENTER in pressed:
+            runs.append(run)
+            run = Run()
+        elif pressed or run.first is not None:
+            if run.first is None:
+                run.first = timestamp
+            run.last = timestamp
+            run.reports += 1
+            run.text += ''.join(key_text(usage, new_mods) for usage in pressed)
+
+        mods, keys = new_mods, new_keys
+
+    if run.text:
+        runs.append(run)
+    return runs, count
+
+
+def read_capture(path):
+    reports = []
+    for line in path.read_text(encoding='utf-8').splitlines():
+        line = line.strip()
+        if not line or line.startswith('#'):
+            continue
+        timestamp, _, hex_bytes = line.partition(' ')
+        reports.append((float(timestamp), bytes.fromhex(hex_bytes)))
+    return reports
+
+
+def capture_hidraw(device, runs, save):
+    """Read reports until the given number of Enter presses (or Ctrl+C)"""
+    reports = []
+    print(f"Reading {device}, press KC_BRST (Ctrl+C to stop)...")
+    fd = os.open(device, os.O_RDONLY)
+    try:
+        while len(decode(reports)[0]) < runs:
+            data = os.read(fd, 64)
+            reports.append((time.monotonic(), data))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        os.close(fd)
+
+    if save:
+        with open(save, 'w', encoding='utf-8') as f:
+            f.write(f"# {device}\n")
+            for timestamp, data in reports:
+                f.write(f"{timestamp:.6f} {data.hex(' ')}\n")
+        print(f"✓ Saved {len(reports)} reports to {save}")
+    return reports
+
+
+def parse_args(argv=None):
+    parser = argparse.ArgumentParser(description="Decode the keyboard reports of the burst output benchmark")
+    parser.add_argument('capture', type=Path, nargs='?', help="Capture file (<seconds> <hex bytes> per line)")
+    parser.add_argument('--hidraw', help="Read the reports from a hidraw device (Linux)")
+    parser.add_argument('--save', help="Save the reports read from --hidraw to a capture file")
+    parser.add_argument('--runs', type=int, default=2, help="Runs to read from --hidraw (default: 2, burst and serial)")
+    parser.add_argument('--expect', help="Expected text (default: KKB_BURST_BENCH_TEXT in burst_macro.h)")
+    args = parser.parse_args(argv)
+    if (args.capture is None) == (args.hidraw is None):
+        parser.error("give a capture file or --hidraw")
+    return args
+
+
+def main(argv=None):
+    args = parse_args(argv)
+    expect = args.expect if args.expect is not None else read_bench_text()
+
+    reports = capture_hidraw(args.hidraw, args.runs, args.save) if args.hidraw else read_capture(args.capture)
+    runs, count = decode(reports)
+    print(f"Reports: {len(reports)} ({count} keyboard), runs: {len(runs)}")
+    print()
+
+    names = ['burst', 'serial'] if len(runs) == 2 else [f'run {i + 1}' for i in range(len(runs))]
+    ok = True
+    for name, run in zip(names, runs):
+        print(f"{name}: {len(run.text)} chars, {run.reports} reports, {run.seconds() * 1000:.1f} ms, {run.cps():.0f} chars/s")
+        print(f"  {run.text}")
+        if expect is not None:
+            if run.text == expect:
+                print("  ✓ Matches the expected text")
+            else:
+                index = next((i for i, (a, b) in enumerate(zip(run.text, expect)) if a != b), min(len(run.text), len(expect)))
+                print(f"  ✗ Differs from the expected text at character {index}")
+                ok = False
+
+    if len(runs) == 2 and runs[0].cps() > 0 and runs[1].cps() > 0:
+        print()
+        print(f"Burst: {runs[0].cps() / runs[1].cps():.2f}x the characters per second, "
+              f"{runs[1].reports / max(runs[0].reports, 1):.2f}x fewer reports")
+
+    if not ok:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
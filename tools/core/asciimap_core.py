@@ -9,8 +9,15 @@ Language-agnostic parsing and rendering engine.
 """
 
 import re
+import importlib.util
 from pathlib import Path
 
+# Load the preprocessor backend from the same folder
+_keymap_cpp_path = Path(__file__).resolve().parent / 'keymap_cpp.py'
+_spec = importlib.util.spec_from_file_location("keymap_cpp", _keymap_cpp_path)
+keymap_cpp = importlib.util.module_from_spec(_spec)
+_spec.loader.exec_module(keymap_cpp)
+
 
 class KeymapVisualizer:
     """Core keymap visualization logic"""
@@ -27,6 +34,7 @@ class KeymapVisualizer:
                 - CUSTOM_KEY_MAPPINGS: dict
                 - RGB_KEY_MAPPINGS: dict
                 - SPECIAL_KEY_MAPPINGS: dict
+                - HOST_DEFINES: dict (optional, used by the 'cpp' backend)
         """
         self.config = layout_config
         self.layout_name = layout_config.LAYOUT_NAME
@@ -35,6 +43,7 @@ class KeymapVisualizer:
         self.custom_keys = layout_config.CUSTOM_KEY_MAPPINGS
         self.rgb_keys = layout_config.RGB_KEY_MAPPINGS
         self.special_keys = layout_config.SPECIAL_KEY_MAPPINGS
+        self.host_defines = getattr(layout_config, 'HOST_DEFINES', {})
 
     def parse_layer_enum(self, original_content):
         """Parse any enum that defines layers"""
@@ -169,10 +178,31 @@ class KeymapVisualizer:
 
         return None
 
+    @staticmethod
+    def split_top_level(content):
+        """Split on commas outside parentheses, so LT(layer, kc) stays one key"""
+        tokens = []
+        depth = 0
+        current = []
+
+        for char in content:
+            if char == '(':
+                depth += 1
+            elif char == ')':
+                depth = max(depth - 1, 0)
+            elif char == ',' and depth == 0:
+                tokens.append(''.join(current))
+                current = []
+                continue
+            current.append(char)
+
+        tokens.append(''.join(current))
+        return tokens
+
     def extract_keys_from_layout_content(self, layer_content, layer_name):
         """Extract keys from LAYOUT_*"""
         clean_content = re.sub(r'\s+', ' ', layer_content).strip()
-        raw_tokens = clean_content.split(',')
+        raw_tokens = self.split_top_level(clean_content)
         keys = []
 
         for i, token in enumerate(raw_tokens):
@@ -184,6 +214,9 @@ class KeymapVisualizer:
             if not re.match(r'^[A-Z_][A-Z0-9_]*\([^)]*\)$', token):
                 token = re.sub(r'\)+\s*$', '', token)
 
+            # Keep the key compact, as the preprocessor backend: LT(_C_FN3,KC_CAPS)
+            token = re.sub(r'\s*,\s*', ',', token)
+
             found_key = None
 
             func_pattern = r'^([A-Z_][A-Z0-9_]*\([^)]*\))$'
@@ -208,8 +241,25 @@ class KeymapVisualizer:
 
         return keys
 
-    def parse_keymap_file(self, filepath):
-        """Parse keymap.c file and extract layers with comments"""
+    def parse_keymap_file(self, filepath, backend='regex', artifact_path=None, cache_dir=None):
+        """
+        Parse keymap.c file and extract layers with comments
+
+        Args:
+            filepath: Path to keymap.c
+            backend: 'regex' (default) or 'cpp' (run the C preprocessor)
+            artifact_path: Optional path to write the 'cpp' backend JSON artifact
+            cache_dir: Optional directory keeping the 'cpp' backend results between runs
+        """
+        if backend == 'cpp':
+            keymap_data = keymap_cpp.extract_keymap(filepath, self.host_defines, cache_dir=cache_dir)
+            if artifact_path:
+                keymap_cpp.write_artifact(keymap_data, artifact_path)
+            return self.parse_keymap_artifact(keymap_data, filepath)
+
+        if backend != 'regex':
+            raise ValueError(f"Unknown keymap backend '{backend}'")
+
         with open(filepath, 'r', encoding='utf-8') as f:
             original_content = f.read()
 
@@ -288,6 +338,28 @@ class KeymapVisualizer:
 
         return layers, layer_order, layer_comments, file_header, layer_enum_mapping
 
+    def parse_keymap_artifact(self, keymap_data, filepath):
+        """
+        Use keymap data from the preprocessor backend (see keymap_cpp.py).
+        Comments are not preserved by the preprocessor, so they are still
+        read from the original source.
+        """
+        with open(filepath, 'r', encoding='utf-8') as f:
+            original_content = f.read()
+
+        layer_comments = self.extract_layer_comments(original_content)
+        file_header = self.extract_file_header_comment(original_content)
+        if file_header:
+            file_header = file_header.strip('@brief').strip()
+
+        layer_order = list(keymap_data['layer_order'])
+        layers = {name: list(keymap_data['layers'][name]['keys']) for name in layer_order}
+        layer_enum_mapping = {name: layer['index'] for name, layer in keymap_data['layers'].items()}
+        for name, number in keymap_data['layer_enum'].items():
+            layer_enum_mapping.setdefault(name, number)
+
+        return layers, layer_order, layer_comments, file_header, layer_enum_mapping
+
     def create_layer_legend(self, layers_data, layer_order, layer_enum_mapping):
         """Create a legend mapping layer numbers to layer names"""
         legend = {}
@@ -298,6 +370,9 @@ class KeymapVisualizer:
                 if key.startswith(('MO(', 'TG(', 'TO(', 'UC(')):
                     layer_ref = key[3:-1]
                     layer_references.add(layer_ref)
+                elif key.startswith('LT('):
+                    layer_ref = key[3:-1].split(',')[0].strip()
+                    layer_references.add(layer_ref)
 
         layer_to_number = {}
 
@@ -336,6 +411,13 @@ class KeymapVisualizer:
             else:
                 return f"MO({layer})"
 
+        if qmk_key.startswith('LT('):
+            layer = qmk_key[3:-1].split(',')[0].strip()
+            if layer in layer_to_number:
+                return f"LT{layer_to_number[layer]}"
+            else:
+                return f"LT({layer})"
+
         if qmk_key.startswith('TG('):
             layer = qmk_key[3:-1]
             if layer in layer_to_number:
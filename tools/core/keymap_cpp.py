@@ -0,0 +1,360 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 kkb (@ktragethon)
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+QMK Keymap extraction through the C preprocessor.
+
+Runs the real C preprocessor over a keymap.c with a given set of defines, so
+keymap-local macros (like the UC_* aliases selected by HOST_LAYOUT_*) resolve
+exactly as they do in the firmware build. QMK's own headers are replaced by
+empty stubs, which keeps QMK keycodes (KC_*, NO_*, MO(), ...) symbolic.
+
+The result is a plain dict that can be written as a JSON artifact, and read
+back by the renderer instead of the regex parser. Results are cached per
+keymap and defines (in memory, and on disk with a cache directory), keyed by
+the contents of the keymap and its local headers, so the preprocessor only
+runs again when one of them changed.
+"""
+
+import os
+import re
+import json
+import shlex
+import hashlib
+import shutil
+import tempfile
+import subprocess
+from pathlib import Path
+
+# Layout macros provided by the keyboard (see keyboard.json)
+LAYOUT_MACROS = ('LAYOUT_69_iso', 'LAYOUT')
+
+# Marker emitted by the stub layout macros. The stringized arguments are the
+# keys as written in the source, the plain arguments are the expanded keys.
+LAYOUT_MARKER = '__kkb_layout__'
+
+KEY_COUNT = 69
+
+# Extraction results of this process, by cache key
+_memory_cache = {}
+
+
+def find_preprocessor():
+    """Find a C preprocessor command, honouring $CPP"""
+    if os.environ.get('CPP'):
+        return shlex.split(os.environ['CPP'])
+
+    for compiler in ('cc', 'gcc', 'clang'):
+        path = shutil.which(compiler)
+        if path:
+            return [path, '-E']
+
+    path = shutil.which('cpp')
+    if path:
+        return [path]
+
+    return None
+
+
+def _find_includes(path, found=None):
+    """Collect all include names reachable from a file, following local headers"""
+    if found is None:
+        found = set()
+
+    include_pattern = r'^\s*#\s*include\s*[<"]([^>"]+)[>"]'
+    content = Path(path).read_text(encoding='utf-8')
+
+    for name in re.findall(include_pattern, content, re.MULTILINE):
+        if name in found:
+            continue
+        found.add(name)
+
+        local = Path(path).parent / name
+        if local.exists():
+            _find_includes(local, found)
+
+    return found
+
+
+def _write_stubs(stub_dir, keymap_path):
+    """Create the keyboard header stub and empty stubs for all non-local headers"""
+    keymap_dir = Path(keymap_path).parent
+
+    for name in _find_includes(keymap_path):
+        if (keymap_dir / name).exists():
+            continue
+        stub = stub_dir / name
+        stub.parent.mkdir(parents=True, exist_ok=True)
+        stub.write_text('#pragma once\n', encoding='utf-8')
+
+    lines = ['#pragma once']
+    for macro in LAYOUT_MACROS:
+        lines.append(f'#define {macro}(...) {LAYOUT_MARKER}(#__VA_ARGS__ ; __VA_ARGS__)')
+
+    keyboard_header = stub_dir / 'kkb_keyboard_stub.h'
+    keyboard_header.write_text('\n'.join(lines) + '\n', encoding='utf-8')
+
+    return keyboard_header.name
+
+
+def preprocess(keymap_path, defines=None, cpp=None):
+    """
+    Run the C preprocessor over a keymap.
+
+    Args:
+        keymap_path: Path to keymap.c
+        defines: Dict of macro names to values (None for a plain -DNAME)
+        cpp: Preprocessor command as a list (default: find_preprocessor())
+
+    Returns:
+        Preprocessed source text
+    """
+    cpp = cpp or find_preprocessor()
+    if not cpp:
+        raise RuntimeError("No C preprocessor found (set $CPP)")
+
+    keymap_path = Path(keymap_path)
+
+    with tempfile.TemporaryDirectory(prefix='kkb_cpp_') as tmp:
+        stub_dir = Path(tmp)
+        keyboard_header = _write_stubs(stub_dir, keymap_path)
+
+        args = cpp + ['-P', '-x', 'c', '-nostdinc',
+                      '-I', str(keymap_path.parent),
+                      '-I', str(stub_dir),
+                      f'-DQMK_KEYBOARD_H="{keyboard_header}"']
+
+        for name, value in (defines or {}).items():
+            args.append(f'-D{name}' if value is None else f'-D{name}={value}')
+
+        args.append(str(keymap_path))
+
+        result = subprocess.run(args, capture_output=True, text=True)
+
+    if result.returncode != 0:
+        raise RuntimeError(f"Preprocessor failed for {keymap_path}:\n{result.stderr.strip()}")
+
+    return result.stdout
+
+
+def _split_top_level(text):
+    """Split on commas that are not nested inside parentheses"""
+    parts = []
+    depth = 0
+    start = 0
+
+    # Only the parentheses and commas matter, skip the text in between
+    for match in re.finditer(r'[(),]', text):
+        char = match.group()
+        if char == '(':
+            depth += 1
+        elif char == ')':
+            depth -= 1
+        elif depth == 0:
+            parts.append(text[start:match.start()])
+            start = match.end()
+
+    parts.append(text[start:])
+    parts = [re.sub(r'\s+', '', part) for part in parts]
+    if parts and not parts[-1]:
+        parts.pop()
+
+    return parts
+
+
+def _read_string_literal(text, pos):
+    """Read a C string literal starting at text[pos] == '"'. Returns (value, end)"""
+    value = []
+    pos += 1
+
+    while pos < len(text):
+        char = text[pos]
+        if char == '\\':
+            value.append(text[pos + 1])
+            pos += 2
+            continue
+        if char == '"':
+            return ''.join(value), pos + 1
+        value.append(char)
+        pos += 1
+
+    raise ValueError("Unterminated string literal in preprocessed output")
+
+
+def _read_balanced(text, pos):
+    """Read until the parenthesis closing the one opened before text[pos]. Returns (content, end)"""
+    depth = 1
+    start = pos
+
+    while pos < len(text) and depth > 0:
+        if text[pos] == '(':
+            depth += 1
+        elif text[pos] == ')':
+            depth -= 1
+        pos += 1
+
+    if depth != 0:
+        raise ValueError("Unbalanced parentheses in preprocessed output")
+
+    return text[start:pos - 1], pos
+
+
+def parse_enums(preprocessed):
+    """Evaluate all enums in preprocessed source. Returns a list of {name: value} dicts"""
+    enums = []
+
+    for match in re.finditer(r'\benum\b\s*\w*\s*\{(.*?)\}', preprocessed, re.DOTALL):
+        mapping = {}
+        value = 0
+
+        for entry in match.group(1).split(','):
+            entry = entry.strip()
+            if not entry:
+                continue
+
+            enum_match = re.match(r'^([A-Za-z_]\w*)\s*(?:=\s*(.+))?$', entry, re.DOTALL)
+            if not enum_match:
+                break
+
+            if enum_match.group(2) is not None:
+                try:
+                    value = int(enum_match.group(2).strip(), 0)
+                except ValueError:
+                    # Not a plain integer (e.g. QK_USER_0), keep the name only
+                    mapping = {}
+                    break
+
+            mapping[enum_match.group(1)] = value
+            value += 1
+
+        if mapping:
+            enums.append(mapping)
+
+    return enums
+
+
+def _cache_key(keymap_path, defines, cpp):
+    """Hash of everything the extraction depends on: this module, the preprocessor, the defines and the sources"""
+    keymap_path = Path(keymap_path)
+    digest = hashlib.sha256()
+
+    digest.update(Path(__file__).read_bytes())
+    digest.update(json.dumps([cpp, sorted((defines or {}).items())], default=str).encode())
+
+    for path in [keymap_path] + [keymap_path.parent / name for name in sorted(_find_includes(keymap_path))]:
+        if path.exists():
+            digest.update(str(path.name).encode())
+            digest.update(path.read_bytes())
+
+    return digest.hexdigest()
+
+
+def extract_keymap(keymap_path, defines=None, cpp=None, cache_dir=None):
+    """
+    Extract the fully resolved keymaps array from a keymap.c.
+
+    The preprocessor runs once per keymap and defines: the result is kept in
+    memory, and in cache_dir when given, until the keymap or one of its
+    local headers changes.
+
+    Returns:
+        Dict with:
+            - source: keymap path
+            - defines: defines used
+            - layer_order: layer designators in keymaps[] order
+            - layer_enum: layer name to layer number
+            - layers: layer name to {'index', 'keys', 'resolved'}
+              where 'keys' are as written in the source and 'resolved' are
+              the same keys after macro expansion
+    """
+    cpp = cpp or find_preprocessor()
+    key = _cache_key(keymap_path, defines, cpp)
+
+    if key in _memory_cache:
+        return dict(_memory_cache[key], source=str(keymap_path))
+
+    cache_path = Path(cache_dir) / f"{Path(keymap_path).parent.name}_{key[:16]}.json" if cache_dir else None
+    if cache_path and cache_path.exists():
+        keymap_data = dict(read_artifact(cache_path), source=str(keymap_path))
+    else:
+        keymap_data = _extract_keymap(keymap_path, defines, cpp)
+        if cache_path:
+            write_artifact(keymap_data, cache_path)
+
+    _memory_cache[key] = keymap_data
+    return keymap_data
+
+
+def _extract_keymap(keymap_path, defines, cpp):
+    """Run the preprocessor over a keymap and read the keymaps array (see extract_keymap())"""
+    preprocessed = preprocess(keymap_path, defines, cpp)
+
+    keymaps_match = re.search(r'\bkeymaps\s*\[\s*\]\s*\[[^\]]*\]\s*\[[^\]]*\]\s*=\s*\{', preprocessed)
+    if not keymaps_match:
+        raise ValueError(f"Could not find keymaps array in {keymap_path}")
+
+    layer_pattern = re.compile(r'\[([^\]]+)\]\s*=\s*' + LAYOUT_MARKER + r'\s*\(\s*')
+
+    layer_order = []
+    layers = {}
+    pos = keymaps_match.end()
+
+    for match in layer_pattern.finditer(preprocessed, pos):
+        layer_name = match.group(1).strip()
+
+        source_text, end = _read_string_literal(preprocessed, match.end())
+        separator = preprocessed.index(';', end)
+        resolved_text, end = _read_balanced(preprocessed, separator + 1)
+
+        keys = _split_top_level(source_text)
+        resolved = _split_top_level(resolved_text)
+
+        if len(keys) != KEY_COUNT or len(resolved) != KEY_COUNT:
+            raise ValueError(f"Layer {layer_name} has {len(keys)} keys, expected {KEY_COUNT}")
+
+        layers[layer_name] = {'keys': keys, 'resolved': resolved}
+        layer_order.append(layer_name)
+
+    if not layer_order:
+        raise ValueError(f"No layers found in keymaps array of {keymap_path}")
+
+    # The layer enum is the one that contains the keymap's layer designators
+    layer_enum = {}
+    for mapping in parse_enums(preprocessed):
+        if any(name in mapping for name in layer_order):
+            layer_enum = mapping
+            break
+
+    for position, layer_name in enumerate(layer_order):
+        if layer_name in layer_enum:
+            layers[layer_name]['index'] = layer_enum[layer_name]
+        elif layer_name.isdigit():
+            layers[layer_name]['index'] = int(layer_name)
+        else:
+            layers[layer_name]['index'] = position
+
+    return {
+        'source': str(keymap_path),
+        'defines': defines or {},
+        'layer_order': layer_order,
+        'layer_enum': layer_enum,
+        'layers': layers
+    }
+
+
+def write_artifact(keymap_data, output_path):
+    """Write extracted keymap data as a JSON artifact"""
+    output_path = Path(output_path)
+    output_path.parent.mkdir(parents=True, exist_ok=True)
+
+    with open(output_path, 'w', encoding='utf-8') as f:
+        json.dump(keymap_data, f, indent=2)
+        f.write('\n')
+
+
+def read_artifact(input_path):
+    """Read a JSON artifact written by write_artifact()"""
+    with open(input_path, 'r', encoding='utf-8') as f:
+        return json.load(f)
@@ -0,0 +1,355 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 kkb (@ktragethon)
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Keymap compiler - derive build-time tables from a keymap.
+
+The LAYOUT_69_iso array in keymap.c is the single description of a keymap.
+This script combines it with the matrix and LED positions in keyboard.json,
+and generates:
+  - keymap_tables.h: per-layer LED bitmasks (active / transparent / no-op),
+    so the RGB renderer does not need to look up and classify every keycode
+    for every frame
+  - keymap_sparse.h: the layers without KC_NO / KC_TRNS (per-layer matrix
+    bitmaps and packed keycodes), read by keycode_at_keymap_location()
+    instead of the dense keymaps[] array (opt-in, KKB_SPARSE_KEYMAP_ENABLE)
+  - ASCII visualisations for all locales (optional, --ascii)
+
+Usage:
+    python3 ./tools/keymap_compiler.py keyboards/kkb/keymaps/code1/keymap.c
+    python3 ./tools/keymap_compiler.py keyboards/kkb/keymaps/code1/keymap.c --check
+"""
+
+import sys
+import json
+import hashlib
+import argparse
+import importlib.util
+from pathlib import Path
+
+tools_dir = Path(__file__).resolve().parent
+sys.path.insert(0, str(tools_dir))
+
+# Import from core subfolder
+core_path = tools_dir / 'core' / 'asciimap_core.py'
+spec = importlib.util.spec_from_file_location("asciimap_core", core_path)
+asciimap_core = importlib.util.module_from_spec(spec)
+spec.loader.exec_module(asciimap_core)
+keymap_cpp = asciimap_core.keymap_cpp
+
+import asciimaps_all
+
+LAYOUT_NAME = 'LAYOUT_69_iso'
+TABLES_FILENAME = 'keymap_tables.h'
+SPARSE_FILENAME = 'keymap_sparse.h'
+
+# Keycodes without function, and transparent keycodes (see QMK keycodes.h)
+NOOP_KEYCODES = ('KC_NO', 'XXXXXXX')
+TRNS_KEYCODES = ('KC_TRNS', '_______', 'KC_TRANSPARENT')
+
+
+def load_led_map(keyboard_json):
+    """Map key index in LAYOUT_69_iso to LED index. Returns (led_map, led_count)"""
+    with open(keyboard_json, 'r', encoding='utf-8') as f:
+        info = json.load(f)
+
+    led_by_matrix = {}
+    for led_index, led in enumerate(info['rgb_matrix']['layout']):
+        led_by_matrix[tuple(led['matrix'])] = led_index
+
+    led_map = []
+    for key in info['layouts'][LAYOUT_NAME]['layout']:
+        led_map.append(led_by_matrix.get(tuple(key['matrix'])))
+
+    return led_map, info['rgb_matrix']['led_count']
+
+
+def load_matrix(keyboard_json):
+    """Map key index in LAYOUT_69_iso to matrix position. Returns (positions, rows, cols)"""
+    with open(keyboard_json, 'r', encoding='utf-8') as f:
+        info = json.load(f)
+
+    positions = [tuple(key['matrix']) for key in info['layouts'][LAYOUT_NAME]['layout']]
+    return positions, len(info['matrix_pins']['rows']), len(info['matrix_pins']['cols'])
+
+
+def classify(keycode):
+    """Classify a resolved keycode as 'noop', 'trns' or 'active'"""
+    if keycode in NOOP_KEYCODES:
+        return 'noop'
+    if keycode in TRNS_KEYCODES:
+        return 'trns'
+    return 'active'
+
+
+def build_masks(keymap_data, led_map, led_count):
+    """Build active and transparent LED bitmasks for every layer, in layer number order"""
+    words = (led_count + 31) // 32
+    layer_count = max(layer['index'] for layer in keymap_data['layers'].values()) + 1
+
+    active = [[0] * words for _ in range(layer_count)]
+    trns = [[0] * words for _ in range(layer_count)]
+    names = [None] * layer_count
+
+    for name, layer in keymap_data['layers'].items():
+        number = layer['index']
+        names[number] = name
+
+        for key_index, keycode in enumerate(layer['resolved']):
+            led = led_map[key_index]
+            if led is None:
+                continue
+
+            kind = classify(keycode)
+            if kind == 'active':
+                active[number][led // 32] |= 1 << (led % 32)
+            elif kind == 'trns':
+                trns[number][led // 32] |= 1 << (led % 32)
+
+    return names, active, trns, words
+
+
+def format_mask_table(name, comment, names, masks):
+    """Format one bitmask table as C"""
+    lines = [f'// {comment}',
+             f'static const uint32_t PROGMEM {name}[KKB_TABLE_LAYER_COUNT][KKB_TABLE_LED_WORDS] = {{']
+
+    for number, mask in enumerate(masks):
+        words = ', '.join(f'0x{word:08X}' for word in mask)
+        lines.append(f'    {{{words}}}, // L{number}: {names[number] or "(unused)"}')
+
+    lines.append('};')
+    return lines
+
+
+def file_header(keymap_path, keymap_data):
+    """Common header of the generated files"""
+    layers_json = json.dumps(keymap_data['layers'], sort_keys=True).encode('utf-8')
+    source_hash = hashlib.sha256(layers_json).hexdigest()[:16]
+
+    return [
+        '// Copyright 2025 kkb (@ktragethon)',
+        '// SPDX-License-Identifier: GPL-2.0-or-later',
+        '',
+        '// GENERATED FILE - DO NOT EDIT',
+        f'// Generated by tools/keymap_compiler.py from {Path(keymap_path).name} (layers sha256: {source_hash})',
+        '',
+        '#pragma once',
+        '',
+    ]
+
+
+def generate_tables(keymap_path, keymap_data, led_map, led_count):
+    """Generate the contents of keymap_tables.h"""
+    names, active, trns, words = build_masks(keymap_data, led_map, led_count)
+
+    lines = file_header(keymap_path, keymap_data) + [
+        f'#define KKB_TABLE_LAYER_COUNT {len(names)}',
+        f'#define KKB_TABLE_LED_COUNT {led_count}',
+        f'#define KKB_TABLE_LED_WORDS {words}',
+        '',
+        '// clang-format off',
+    ]
+    lines += format_mask_table('kkb_layer_active_mask', 'LEDs of keys with a function (keycode > KC_TRNS)', names, active)
+    lines.append('')
+    lines += format_mask_table('kkb_layer_trns_mask', 'LEDs of transparent keys (KC_TRNS)', names, trns)
+    lines += [
+        '// clang-format on',
+        '',
+        '// Test LED bit in a layer mask table',
+        '#define KKB_TABLE_TEST(table, layer, led) \\',
+        '    ((pgm_read_dword(&(table)[(layer)][(led) >> 5]) >> ((led) & 31)) & 1)',
+        '',
+    ]
+
+    return '\n'.join(lines)
+
+
+def build_sparse(keymap_data, positions, rows, cols):
+    """Split every layer into matrix bitmaps (keycode / transparent) and packed keycodes"""
+    words = (rows * cols + 31) // 32
+    layer_count = max(layer['index'] for layer in keymap_data['layers'].values()) + 1
+
+    present = [[0] * words for _ in range(layer_count)]
+    trns = [[0] * words for _ in range(layer_count)]
+    base = [[0] * words for _ in range(layer_count)]
+    packed = [[] for _ in range(layer_count)]
+    names = [None] * layer_count
+
+    for name, layer in keymap_data['layers'].items():
+        number = layer['index']
+        names[number] = name
+
+        # Keys as written in keymap.c (aliases follow the host layout at build time), by matrix position
+        by_position = {}
+        for key_index, keycode in enumerate(layer['resolved']):
+            row, col = positions[key_index]
+            by_position[row * cols + col] = (classify(keycode), layer['keys'][key_index])
+
+        for position in sorted(by_position):
+            kind, key = by_position[position]
+            if kind == 'active':
+                present[number][position // 32] |= 1 << (position % 32)
+                packed[number].append((position, key))
+            elif kind == 'trns':
+                trns[number][position // 32] |= 1 << (position % 32)
+
+    # Index of the first packed keycode of every bitmap word
+    index = 0
+    for number in range(layer_count):
+        for word in range(words):
+            base[number][word] = index
+            index += bin(present[number][word]).count('1')
+
+    return names, present, trns, base, packed, words
+
+
+def sparse_sizes(layer_count, words, keycode_count, rows, cols):
+    """Flash used by the dense keymaps[] array and by the sparse tables, in bytes"""
+    dense = layer_count * rows * cols * 2
+    sparse = layer_count * words * (4 + 4 + 2) + keycode_count * 2
+    return dense, sparse
+
+
+def generate_sparse(keymap_path, keymap_data, positions, rows, cols):
+    """Generate the contents of keymap_sparse.h"""
+    names, present, trns, base, packed, words = build_sparse(keymap_data, positions, rows, cols)
+    keycode_count = sum(len(layer) for layer in packed)
+    dense, sparse = sparse_sizes(len(names), words, keycode_count, rows, cols)
+
+    lines = file_header(keymap_path, keymap_data) + [
+        f'#define KKB_SPARSE_LAYER_COUNT {len(names)}',
+        f'#define KKB_SPARSE_ROWS {rows}',
+        f'#define KKB_SPARSE_COLS {cols}',
+        f'#define KKB_SPARSE_WORDS {words}',
+        f'#define KKB_SPARSE_KEYCODE_COUNT {keycode_count}',
+        '',
+        '// Flash (bytes) of the dense keymaps[] array and of these tables',
+        f'#define KKB_SPARSE_DENSE_BYTES {dense}',
+        f'#define KKB_SPARSE_BYTES {sparse}',
+        '',
+        '// clang-format off',
+        '// Matrix positions (row * cols + col) with a keycode in kkb_sparse_keycodes',
+        'static const uint32_t PROGMEM kkb_sparse_present[KKB_SPARSE_LAYER_COUNT][KKB_SPARSE_WORDS] = {',
+    ]
+    for number, mask in enumerate(present):
+        lines.append(f'    {{{", ".join(f"0x{word:08X}" for word in mask)}}}, // L{number}: {names[number] or "(unused)"}')
+    lines += [
+        '};',
+        '',
+        '// Matrix positions of transparent keys (KC_TRNS), all others are KC_NO',
+        'static const uint32_t PROGMEM kkb_sparse_trns[KKB_SPARSE_LAYER_COUNT][KKB_SPARSE_WORDS] = {',
+    ]
+    for number, mask in enumerate(trns):
+        lines.append(f'    {{{", ".join(f"0x{word:08X}" for word in mask)}}}, // L{number}: {names[number] or "(unused)"}')
+    lines += [
+        '};',
+        '',
+        '// Index in kkb_sparse_keycodes of the first keycode of every bitmap word',
+        'static const uint16_t PROGMEM kkb_sparse_base[KKB_SPARSE_LAYER_COUNT][KKB_SPARSE_WORDS] = {',
+    ]
+    for number, offsets in enumerate(base):
+        lines.append(f'    {{{", ".join(f"{offset:3}" for offset in offsets)}}}, // L{number}: {names[number] or "(unused)"}')
+    lines += [
+        '};',
+        '',
+        '// Keycodes of all layers, in layer and matrix position order',
+        'static const uint16_t PROGMEM kkb_sparse_keycodes[KKB_SPARSE_KEYCODE_COUNT] = {',
+    ]
+    for number, keys in enumerate(packed):
+        if not keys:
+            continue
+        lines.append(f'    // L{number}: {names[number]}')
+        for start in range(0, len(keys), 8):
+            lines.append('    ' + ' '.join(f'{key},' for _, key in keys[start:start + 8]))
+    lines += [
+        '};',
+        '// clang-format on',
+        '',
+    ]
+
+    return '\n'.join(lines), dense, sparse
+
+
+def generate_ascii(keymap_info, output_dir):
+    """Generate ASCII maps for all locales, through the preprocessor backend"""
+    output_dir.mkdir(parents=True, exist_ok=True)
+    failed = 0
+
+    for layout in asciimaps_all.discover_layouts():
+        print(f"  Layout: {layout}...", end=" ")
+        if not asciimaps_all.generate_ascii_map(keymap_info, layout, output_dir, 'cpp'):
+            failed += 1
+
+    return failed == 0
+
+
+def parse_args(argv=None):
+    """Parse command line arguments"""
+    parser = argparse.ArgumentParser(description="Generate build-time tables from a keymap")
+    parser.add_argument('keymap', type=Path, help="Path to the keymap.c")
+    parser.add_argument('--keyboard-json', type=Path, default=None,
+                        help="Path to keyboard.json (default: two levels above the keymap folder)")
+    parser.add_argument('--check', action='store_true',
+                        help=f"Only check that {TABLES_FILENAME} is up to date")
+    parser.add_argument('--ascii', action='store_true',
+                        help="Also generate ASCII maps for all locales (tools/asciimaps/user/)")
+    return parser.parse_args(argv)
+
+
+def main(argv=None):
+    args = parse_args(argv)
+
+    keymap_path = args.keymap.resolve()
+    if not keymap_path.is_file():
+        print(f"Error: File '{keymap_path}' does not exist")
+        sys.exit(1)
+
+    keyboard_json = args.keyboard_json or keymap_path.parents[2] / 'keyboard.json'
+    if not keyboard_json.is_file():
+        print(f"Error: keyboard.json not found at '{keyboard_json}'")
+        sys.exit(1)
+
+    # LED bitmasks do not depend on the host layout, every alias is a real keycode
+    keymap_data = keymap_cpp.extract_keymap(keymap_path)
+    led_map, led_count = load_led_map(keyboard_json)
+    positions, rows, cols = load_matrix(keyboard_json)
+    sparse, dense_bytes, sparse_bytes = generate_sparse(keymap_path, keymap_data, positions, rows, cols)
+    outputs = {
+        keymap_path.parent / TABLES_FILENAME: generate_tables(keymap_path, keymap_data, led_map, led_count),
+        keymap_path.parent / SPARSE_FILENAME: sparse,
+    }
+
+    if args.check:
+        out_of_date = False
+        for path, contents in outputs.items():
+            current = path.read_text(encoding='utf-8') if path.exists() else None
+            if current != contents:
+                print(f"✗ {path} is out of date, run: python3 ./tools/keymap_compiler.py {args.keymap}")
+                out_of_date = True
+            else:
+                print(f"✓ {path} is up to date")
+        if out_of_date:
+            sys.exit(1)
+        return
+
+    for path, contents in outputs.items():
+        path.write_text(contents, encoding='utf-8')
+        print(f"✓ Generated: {path}")
+    print(f"  Sparse keymap: {sparse_bytes} bytes instead of {dense_bytes} ({dense_bytes - sparse_bytes} bytes saved)")
+
+    if args.ascii:
+        keymap_info = {
+            'path': keymap_path,
+            'keymap_name': keymap_path.parent.name,
+            'keyboard_name': keyboard_json.parent.name,
+            'display_name': f"{keyboard_json.parent.name}/{keymap_path.parent.name}"
+        }
+        if not generate_ascii(keymap_info, tools_dir / 'asciimaps' / 'user'):
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
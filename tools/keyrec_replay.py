@@ -0,0 +1,647 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 kkb (@ktragethon)
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Key event recorder replay.
+
+Reads a key recorder dump (KREC lines from the console, see
+keyboards/kkb/key_recorder.c) and feeds the raw matrix changes through a
+model of the firmware pipeline: debounce, layer resolution with the keymap
+(through the preprocessor backend), the kkb key-combos and the keymap's
+keycodes. Prints every key event and the resulting keyboard report, with
+timestamps, so a recording from a keyboard can be examined offline.
+
+The pipeline is a model of QMK, not QMK itself:
+  - Debounce: the keyboard's per-key adaptive debounce (adaptive_debounce.c,
+    DEBOUNCE_TYPE = custom), or QMK's sym_defer_g or sym_eager_pk. The
+    adaptive model runs on the firmware's ms timer and starts every key at
+    KKB_DEBOUNCE_START, as after a reset
+  - Layers: MO(), TG(), TO(), KC_TRNS fall-through, and the source layer of a
+    pressed key is kept until it is released (as QMK's layer cache)
+  - LT(): the predictive tap-hold of keyboards/kkb/tap_hold.c, when the keymap
+    config.h defines KKB_TAP_HOLD_ENABLE (decision latencies are summarised)
+  - Reports: NKRO style, a set of modifiers and keys
+Keycodes handled by keymap code (e.g. RM_VALU, QK_BOOT) are listed as events
+without a report. Host language aliases (NO_*) are reported by name.
+
+Usage:
+    python3 ./tools/keyrec_replay.py console.log keyboards/kkb/keymaps/code1/keymap.c
+    python3 ./tools/keyrec_replay.py console.log keyboards/kkb/keymaps/code1/keymap.c --dip 1
+    python3 ./tools/keyrec_replay.py console.log keyboards/kkb/keymaps/code1/keymap.c --algorithm sym_defer_g --debounce 5
+    python3 ./tools/keyrec_replay.py console.log keyboards/kkb/keymaps/code1/keymap.c --tap-hold-flow 120
+"""
+
+import re
+import json
+import argparse
+import importlib.util
+from pathlib import Path
+
+tools_dir = Path(__file__).resolve().parent
+
+# Import from core subfolder
+core_path = tools_dir / 'core' / 'keymap_cpp.py'
+spec = importlib.util.spec_from_file_location("keymap_cpp", core_path)
+keymap_cpp = importlib.util.module_from_spec(spec)
+spec.loader.exec_module(keymap_cpp)
+
+LAYOUT_NAME = 'LAYOUT_69_iso'
+
+# Modifier keycodes, and the wrappers that add them to a keycode
+MODIFIER_KEYCODES = ('KC_LCTL', 'KC_LSFT', 'KC_LALT', 'KC_LGUI', 'KC_RCTL', 'KC_RSFT', 'KC_RALT', 'KC_RGUI')
+MODIFIER_WRAPPERS = {
+    'LCTL': ['KC_LCTL'], 'C': ['KC_LCTL'],
+    'LSFT': ['KC_LSFT'], 'S': ['KC_LSFT'],
+    'LALT': ['KC_LALT'], 'A': ['KC_LALT'], 'LOPT': ['KC_LALT'],
+    'LGUI': ['KC_LGUI'], 'G': ['KC_LGUI'], 'LCMD': ['KC_LGUI'], 'LWIN': ['KC_LGUI'],
+    'RCTL': ['KC_RCTL'], 'RSFT': ['KC_RSFT'],
+    'RALT': ['KC_RALT'], 'ALGR': ['KC_RALT'], 'ROPT': ['KC_RALT'],
+    'RGUI': ['KC_RGUI'], 'RCMD': ['KC_RGUI'], 'RWIN': ['KC_RGUI'],
+    'LCA': ['KC_LCTL', 'KC_LALT'], 'LCS': ['KC_LCTL', 'KC_LSFT'], 'LSA': ['KC_LSFT', 'KC_LALT'],
+    'MEH': ['KC_LCTL', 'KC_LSFT', 'KC_LALT'], 'HYPR': ['KC_LCTL', 'KC_LSFT', 'KC_LALT', 'KC_LGUI'],
+}
+MODIFIER_ALIASES = {'KC_LCMD': 'KC_LGUI', 'KC_LWIN': 'KC_LGUI', 'KC_RCMD': 'KC_RGUI', 'KC_RWIN': 'KC_RGUI',
+                    'KC_ALGR': 'KC_RALT', 'KC_LOPT': 'KC_LALT', 'KC_ROPT': 'KC_RALT'}
+
+# Keycodes that are neither sent to the host nor change layers
+NOOP_KEYCODES = ('KC_NO', 'XXXXXXX')
+TRNS_KEYCODES = ('KC_TRNS', '_______', 'KC_TRANSPARENT')
+
+# Tap-hold decisions and latency buckets (ms), as keyboards/kkb/tap_hold.h
+TAP_HOLD_DECISIONS = ('tap_flow', 'tap_roll', 'tap_release', 'hold_key', 'hold_alone')
+TAP_HOLD_BUCKETS_MS = (10, 25, 50, 100, 200)
+
+# Adaptive debounce defaults, as keyboards/kkb/adaptive_debounce.h
+ADAPTIVE_DEBOUNCE_DEFAULTS = {'KKB_DEBOUNCE_MIN': 2, 'KKB_DEBOUNCE_MAX': 20, 'KKB_DEBOUNCE_START': 5,
+                              'KKB_DEBOUNCE_CLEAN_STEPS': 64}
+
+
+def parse_dump(lines):
+    """Parse KREC lines. Returns (records, cpu_hz, dropped) with records as (cycles, ms, row, state)"""
+    records = []
+    cpu_hz = None
+    dropped = 0
+
+    for line in lines:
+        begin = re.search(r'KREC BEGIN (\d+) (\d+) (\d+)', line)
+        if begin:
+            records = []
+            cpu_hz = int(begin.group(2))
+            dropped = int(begin.group(3))
+            continue
+
+        record = re.search(r'KREC ([0-9A-Fa-f]{8}) ([0-9A-Fa-f]{4}) (\d+) ([0-9A-Fa-f]+)', line)
+        if record:
+            records.append((int(record.group(1), 16), int(record.group(2), 16),
+                            int(record.group(3)), int(record.group(4), 16)))
+
+    if cpu_hz is None:
+        raise ValueError("No 'KREC BEGIN' line found in dump")
+
+    return records, cpu_hz, dropped
+
+
+def unwrap_times(records, cpu_hz):
+    """Convert cycle counter values to microseconds from the first record"""
+    times = []
+    wrap_ms = (1 << 32) * 1000 // cpu_hz
+    elapsed = 0
+
+    for i, (cycles, ms, _, _) in enumerate(records):
+        if i > 0:
+            prev_cycles, prev_ms = records[i - 1][0], records[i - 1][1]
+            delta_cycles = (cycles - prev_cycles) & 0xFFFFFFFF
+            delta_ms = (ms - prev_ms) & 0xFFFF
+
+            # The cycle counter wraps every ~wrap_ms, fall back to the ms timer for long gaps
+            if delta_ms + 1 >= wrap_ms:
+                elapsed += delta_ms * 1000
+            else:
+                elapsed += delta_cycles * 1000000 / cpu_hz
+        times.append(elapsed)
+
+    return times
+
+
+def unwrap_timer(records):
+    """The firmware's 16-bit ms timer of each record, in ms from the first record's timer tick"""
+    ticks = []
+    elapsed = 0
+
+    for i, (_, ms, _, _) in enumerate(records):
+        if i > 0:
+            elapsed += (ms - records[i - 1][1]) & 0xFFFF
+        ticks.append(elapsed)
+
+    return ticks
+
+
+def debounce(changes, debounce_ms, algorithm, adaptive=None):
+    """
+    Apply debounce to raw row changes.
+
+    Args:
+        changes: list of (time_us, tick_ms, row, state), tick_ms is the firmware's ms timer
+        adaptive: KKB_DEBOUNCE_* values for the 'adaptive' algorithm (see load_debounce_config())
+    Returns:
+        list of (time_us, row, col, pressed) key changes, in QMK scan order per time
+    """
+    if algorithm == 'adaptive':
+        return debounce_adaptive(changes, adaptive or dict(ADAPTIVE_DEBOUNCE_DEFAULTS, KKB_DEBOUNCE_START=debounce_ms))
+
+    debounce_us = debounce_ms * 1000
+    events = []
+
+    if algorithm == 'sym_defer_g':
+        raw = {}
+        cooked = {}
+        for i, (time_us, _, row, state) in enumerate(changes):
+            raw[row] = state
+            next_time = changes[i + 1][0] if i + 1 < len(changes) else None
+
+            # Raw matrix stable for the debounce time: copy to cooked
+            if next_time is None or next_time - time_us >= debounce_us:
+                commit_time = time_us + debounce_us
+                for r in sorted(raw):
+                    delta = raw[r] ^ cooked.get(r, 0)
+                    for col in range(16):
+                        if delta & (1 << col):
+                            events.append((commit_time, r, col, bool(raw[r] & (1 << col))))
+                    cooked[r] = raw[r]
+        return events
+
+    if algorithm == 'sym_eager_pk':
+        # Per key: a change is reported at once, then the key is ignored for the
+        # debounce time. If it differs from the reported state when that time
+        # has passed, the new state is reported then.
+        key_changes = {}
+        previous = {}
+        for time_us, _, row, state in changes:
+            delta = state ^ previous.get(row, 0)
+            previous[row] = state
+            for col in range(16):
+                if delta & (1 << col):
+                    key_changes.setdefault((row, col), []).append((time_us, bool(state & (1 << col))))
+
+        for (row, col), timeline in key_changes.items():
+            raw = cooked = False
+            cooldown_end = None
+
+            for time_us, state in timeline + [(float('inf'), None)]:
+                if cooldown_end is not None and cooldown_end <= time_us:
+                    if raw != cooked:
+                        cooked = raw
+                        events.append((cooldown_end, row, col, cooked))
+                        cooldown_end += debounce_us
+                    if cooldown_end <= time_us:
+                        cooldown_end = None
+
+                if state is None:
+                    break
+
+                raw = state
+                if cooldown_end is None and raw != cooked:
+                    cooked = raw
+                    events.append((time_us, row, col, cooked))
+                    cooldown_end = time_us + debounce_us
+
+        return sorted(events, key=lambda e: (e[0], e[1], e[2]))
+
+    raise ValueError(f"Unknown debounce algorithm '{algorithm}'")
+
+
+def debounce_adaptive(changes, config):
+    """
+    Per-key adaptive debounce, as keyboards/kkb/adaptive_debounce.c.
+
+    A key that differs from its debounced state opens a window of its own
+    debounce time, every raw transition inside the window restarts it, and
+    the state is committed when the window ends (on the ms timer tick, before
+    a change in the same tick). A window with a bounce raises the key's time
+    by 1 ms, KKB_DEBOUNCE_CLEAN_STEPS clean windows lower it by 1 ms.
+    """
+    minimum, maximum = config['KKB_DEBOUNCE_MIN'], config['KKB_DEBOUNCE_MAX']
+    clean_steps = config['KKB_DEBOUNCE_CLEAN_STEPS']
+
+    # Per key transitions, with the time of the first record as the reference for ticks
+    offset_us = changes[0][0] - changes[0][1] * 1000 if changes else 0
+    key_changes = {}
+    previous = {}
+    for time_us, tick_ms, row, state in changes:
+        delta = state ^ previous.get(row, 0)
+        previous[row] = state
+        for col in range(16):
+            if delta & (1 << col):
+                key_changes.setdefault((row, col), []).append((tick_ms, bool(state & (1 << col))))
+
+    events = []
+    for (row, col), timeline in key_changes.items():
+        raw = cooked = bounced = False
+        debounce_ms = config['KKB_DEBOUNCE_START']
+        clean = 0
+        window_end = None
+
+        for tick_ms, state in timeline + [(float('inf'), None)]:
+            if window_end is not None and window_end <= tick_ms:
+                # Stable for the key's debounce time: commit, if still different
+                if raw != cooked:
+                    cooked = raw
+                    events.append((offset_us + window_end * 1000, row, col, cooked))
+                if bounced:
+                    clean = 0
+                    debounce_ms = min(debounce_ms + 1, maximum)
+                else:
+                    clean += 1
+                    if clean >= clean_steps:
+                        clean = 0
+                        debounce_ms = max(debounce_ms - 1, minimum)
+                window_end = None
+
+            if state is None:
+                break
+
+            raw = state
+            if window_end is None:
+                if raw != cooked:
+                    window_end = tick_ms + debounce_ms
+                    bounced = False
+            else:
+                # Bounce: restart the window
+                bounced = True
+                window_end = tick_ms + debounce_ms
+
+    # Scan order: by time, then row and column
+    return sorted(events, key=lambda e: (e[0], e[1], e[2]))
+
+
+def load_key_combos(kkb_c):
+    """Read key_comb_list from kkb.c. Returns {keycode: [keys]}"""
+    names = ('KC_TASK', 'KC_FILE', 'KC_SNAP', 'KC_CTANA')
+    content = Path(kkb_c).read_text(encoding='utf-8')
+
+    list_match = re.search(r'key_comb_list\[\d+\]\s*=\s*\{(.*?)\};', content, re.DOTALL)
+    if not list_match:
+        return {}
+
+    combos = re.findall(r'\{\s*\d+\s*,\s*\{([^}]*)\}\s*\}', list_match.group(1))
+    return {name: [key.strip() for key in combo.split(',')] for name, combo in zip(names, combos)}
+
+
+def load_matrix_map(keyboard_json):
+    """Map (row, col) to key index in LAYOUT_69_iso"""
+    with open(keyboard_json, 'r', encoding='utf-8') as f:
+        info = json.load(f)
+
+    return {tuple(key['matrix']): index for index, key in enumerate(info['layouts'][LAYOUT_NAME]['layout'])}
+
+
+def load_debounce_config(config_files):
+    """Read KKB_DEBOUNCE_* (and DEBOUNCE, the start value) from config.h files, later files win"""
+    config = dict(ADAPTIVE_DEBOUNCE_DEFAULTS)
+    names = ('DEBOUNCE',) + tuple(ADAPTIVE_DEBOUNCE_DEFAULTS)
+
+    for config_h in config_files:
+        if not Path(config_h).is_file():
+            continue
+        content = Path(config_h).read_text(encoding='utf-8')
+        for name in names:
+            match = re.search(rf'^\s*#\s*define\s+{name}\s+(\d+)', content, re.MULTILINE)
+            if match:
+                config['KKB_DEBOUNCE_START' if name == 'DEBOUNCE' else name] = int(match.group(1))
+
+    return config
+
+
+def load_tap_hold_config(config_h):
+    """Read KKB_TAP_HOLD_* from a keymap config.h. Returns {'flow_ms', 'term_ms'} or None if disabled"""
+    if not Path(config_h).is_file():
+        return None
+
+    content = Path(config_h).read_text(encoding='utf-8')
+    if not re.search(r'^\s*#\s*define\s+KKB_TAP_HOLD_ENABLE\b', content, re.MULTILINE):
+        return None
+
+    config = {'flow_ms': 150, 'term_ms': 200}
+    for name, key in (('KKB_TAP_HOLD_FLOW_MS', 'flow_ms'), ('KKB_TAP_HOLD_TERM', 'term_ms'), ('TAPPING_TERM', 'term_ms')):
+        match = re.search(rf'^\s*#\s*define\s+{name}\s+(\d+)', content, re.MULTILINE)
+        if match and not (name == 'TAPPING_TERM' and 'KKB_TAP_HOLD_TERM' in content):
+            config[key] = int(match.group(1))
+
+    return config
+
+
+class Pipeline:
+    """Model of the QMK key processing for a kkb keymap"""
+
+    def __init__(self, keymap_data, matrix_map, combos, default_layer, tap_hold=None):
+        self.layer_enum = dict(keymap_data['layer_enum'])
+        self.layers = {layer['index']: layer['resolved'] for layer in keymap_data['layers'].values()}
+        self.matrix_map = matrix_map
+        self.combos = combos
+        self.default_layer_state = 1 << default_layer
+        self.layer_state = 0
+        self.source_layer = {}
+        self.mods = []
+        self.keys = []
+
+        # Tap-hold model (tap_hold.c), one LT() key at a time
+        self.tap_hold = tap_hold
+        self.th_state = 'idle'
+        self.th_key = None
+        self.th_layer = None
+        self.th_tap = None
+        self.th_press_ms = 0
+        self.th_last_press_ms = None
+        self.th_decisions = []
+
+    def layer_number(self, name):
+        return self.layer_enum[name] if name in self.layer_enum else int(name, 0)
+
+    def keycode_at(self, layer, key_index):
+        keys = self.layers.get(layer)
+        return keys[key_index] if keys else 'KC_TRNS'
+
+    def resolve(self, key_index):
+        """Highest active layer with a non-transparent keycode"""
+        state = self.layer_state | self.default_layer_state
+        for layer in sorted(self.layers, reverse=True):
+            if state & (1 << layer):
+                keycode = self.keycode_at(layer, key_index)
+                if keycode not in TRNS_KEYCODES:
+                    return layer, keycode
+        return 0, 'KC_NO'
+
+    def report(self):
+        mods = ' '.join(mod[3:] for mod in self.mods)
+        keys = ' '.join(self.keys)
+        return f"[{mods}] {keys}".rstrip()
+
+    def expand(self, keycode):
+        """Split a keycode into the modifiers and keys it registers"""
+        keycode = MODIFIER_ALIASES.get(keycode, keycode)
+
+        if keycode in self.combos:
+            mods = [key for key in self.combos[keycode] if key in MODIFIER_KEYCODES or key in MODIFIER_ALIASES]
+            keys = [key for key in self.combos[keycode] if key not in mods]
+            return [MODIFIER_ALIASES.get(mod, mod) for mod in mods], keys
+
+        wrapper = re.match(r'^([A-Z]+)\((.*)\)$', keycode)
+        if wrapper and wrapper.group(1) in MODIFIER_WRAPPERS:
+            mods, keys = self.expand(wrapper.group(2))
+            return MODIFIER_WRAPPERS[wrapper.group(1)] + mods, keys
+
+        if keycode in MODIFIER_KEYCODES:
+            return [keycode], []
+
+        return [], [keycode]
+
+    def register(self, keycode, pressed):
+        """Add or remove a keycode from the report. Returns the new report"""
+        mods, keys = self.expand(keycode)
+        for mod in mods:
+            if pressed and mod not in self.mods:
+                self.mods.append(mod)
+            elif not pressed and mod in self.mods:
+                self.mods.remove(mod)
+        for key in keys:
+            if pressed and key not in self.keys:
+                self.keys.append(key)
+            elif not pressed and key in self.keys:
+                self.keys.remove(key)
+        return self.report()
+
+    def tap(self, keycode):
+        """tap_code16(): press and release. Returns the two reports"""
+        return [self.register(keycode, True), self.register(keycode, False)]
+
+    def th_decide(self, decision, latency_ms):
+        self.th_decisions.append((decision, latency_ms))
+        return decision
+
+    def tap_hold_process(self, key_index, pressed, time_ms):
+        """
+        pre_process_record_kb() with tap_hold.c. Returns (handled, description, reports),
+        description and reports also for events that continue to normal processing
+        """
+        description = None
+        reports = []
+
+        if not pressed:
+            if self.th_state == 'idle' or key_index != self.th_key:
+                return False, None, []
+
+            held = time_ms - self.th_press_ms
+            if self.th_state == 'pending':
+                self.layer_state &= ~(1 << self.th_layer)
+                if held < self.tap_hold['term_ms']:
+                    reports = self.tap(self.th_tap)
+                    description = self.th_decide('tap_release', held)
+                else:
+                    description = self.th_decide('hold_alone', held)
+            elif self.th_state == 'hold':
+                self.layer_state &= ~(1 << self.th_layer)
+                description = 'release hold'
+            elif self.th_state == 'tap':
+                reports = [self.register(self.th_tap, False)]
+                description = 'release tap'
+            else:
+                description = 'release (tap sent)'
+
+            self.th_state = 'idle'
+            return True, f"{description}, layer_state=0x{self.layer_state:X}", reports
+
+        if self.th_state == 'pending':
+            latency = time_ms - self.th_press_ms
+            if latency < self.tap_hold['term_ms'] and self.keycode_at(self.th_layer, key_index) in NOOP_KEYCODES:
+                # Roll within the term: tap before the key is processed on the layers below
+                self.layer_state &= ~(1 << self.th_layer)
+                reports = self.tap(self.th_tap)
+                self.th_state = 'done'
+                description = f"{self.th_decide('tap_roll', latency)} {self.th_tap}"
+            else:
+                self.th_state = 'hold'
+                description = self.th_decide('hold_key', latency)
+
+        _, keycode = self.resolve(key_index)
+        layer_tap = re.match(r'^LT\((.*),(.*)\)$', keycode)
+
+        if layer_tap and self.th_state == 'idle':
+            self.th_key = key_index
+            self.th_layer = self.layer_number(layer_tap.group(1).strip())
+            self.th_tap = layer_tap.group(2).strip()
+            self.th_press_ms = time_ms
+
+            # No flow tap for Caps Lock (tap_hold_flow_key())
+            last = self.th_last_press_ms
+            if last is not None and self.th_tap != 'KC_CAPS' and time_ms - last < self.tap_hold['flow_ms']:
+                reports.append(self.register(self.th_tap, True))
+                self.th_state = 'tap'
+                description = f"{self.th_decide('tap_flow', 0)} {self.th_tap}"
+            else:
+                self.layer_state |= 1 << self.th_layer
+                self.th_state = 'pending'
+                description = f"pending, layer_state=0x{self.layer_state:X}"
+            return True, description, reports
+
+        # Typing speed: only keys that type count
+        if keycode.startswith('KC_') and keycode not in MODIFIER_KEYCODES + NOOP_KEYCODES + TRNS_KEYCODES:
+            self.th_last_press_ms = time_ms
+
+        return False, description, reports
+
+    def process(self, key_index, pressed, time_ms=0):
+        """Process one key event. Returns (keycode, description, reports)"""
+        prefix = ''
+        reports = []
+
+        if self.tap_hold:
+            handled, th_description, reports = self.tap_hold_process(key_index, pressed, time_ms)
+            if handled:
+                return 'tap-hold', th_description, reports
+            if th_description:
+                prefix = f"({th_description}) "
+
+        if pressed:
+            layer, keycode = self.resolve(key_index)
+            self.source_layer[key_index] = layer
+        else:
+            layer = self.source_layer.pop(key_index, None)
+            if layer is None:
+                layer, keycode = self.resolve(key_index)
+            keycode = self.keycode_at(layer, key_index)
+
+        if keycode in NOOP_KEYCODES:
+            return keycode, prefix + 'no-op', reports
+
+        layer_action = re.match(r'^(MO|TG|TO)\((.*)\)$', keycode)
+        if layer_action:
+            action, target = layer_action.group(1), self.layer_number(layer_action.group(2))
+            if action == 'MO':
+                self.layer_state = self.layer_state | (1 << target) if pressed else self.layer_state & ~(1 << target)
+            elif action == 'TG' and not pressed:
+                self.layer_state ^= 1 << target
+            elif action == 'TO' and pressed:
+                self.layer_state = 1 << target
+            return keycode, prefix + f"layer_state=0x{self.layer_state:X}", reports
+
+        if not keycode.startswith(('KC_', 'NO_')) and keycode not in self.combos \
+                and not re.match(r'^[A-Z]+\(', keycode):
+            return keycode, prefix + 'keymap/user code', reports
+
+        if keycode.startswith('LT('):
+            return keycode, prefix + 'LT() without KKB_TAP_HOLD_ENABLE (QMK tapping term, not modelled)', reports
+
+        reports.append(self.register(keycode, pressed))
+        return keycode, prefix + f"layer {layer}", reports
+
+    def tap_hold_summary(self):
+        """Decision latency histogram lines, as the TAPH dump of tap_hold.c"""
+        header = ' '.join(f"<{limit:<4}" for limit in TAP_HOLD_BUCKETS_MS) + f" >={TAP_HOLD_BUCKETS_MS[-1]}"
+        lines = [f"{'decision':<12} {header}"]
+
+        for decision in TAP_HOLD_DECISIONS:
+            buckets = [0] * (len(TAP_HOLD_BUCKETS_MS) + 1)
+            for name, latency in self.th_decisions:
+                if name == decision:
+                    bucket = sum(1 for limit in TAP_HOLD_BUCKETS_MS if latency >= limit)
+                    buckets[bucket] += 1
+            lines.append((f"{decision:<12} " + ' '.join(f"{count:<5}" for count in buckets)).rstrip())
+
+        return lines
+
+
+def parse_args(argv=None):
+    """Parse command line arguments"""
+    parser = argparse.ArgumentParser(description="Replay a key recorder dump through a model of the firmware")
+    parser.add_argument('dump', type=Path, help="Console log containing a KREC dump")
+    parser.add_argument('keymap', type=Path, help="Path to the keymap.c used when recording")
+    parser.add_argument('--dip', type=int, choices=(0, 1), default=0,
+                        help="DIP switch position (default layer), as dip_switch_update_kb() (default: 0)")
+    parser.add_argument('--debounce', type=int, default=None,
+                        help="DEBOUNCE in ms, the start value of the adaptive debounce (default: from config.h, or 5)")
+    parser.add_argument('--algorithm', choices=('adaptive', 'sym_defer_g', 'sym_eager_pk'), default='adaptive',
+                        help="DEBOUNCE_TYPE: the keyboard's adaptive debounce, or a QMK algorithm (default: adaptive)")
+    parser.add_argument('-D', dest='defines', action='append', default=[],
+                        help="Define for the keymap, e.g. -D HOST_LAYOUT_US=1")
+    parser.add_argument('--tap-hold-flow', type=int, default=None,
+                        help="KKB_TAP_HOLD_FLOW_MS (default: from the keymap config.h, or 150)")
+    parser.add_argument('--tap-hold-term', type=int, default=None,
+                        help="KKB_TAP_HOLD_TERM (default: from the keymap config.h, or 200)")
+    parser.add_argument('--no-tap-hold', action='store_true',
+                        help="Do not model tap_hold.c, even if the keymap enables it")
+    return parser.parse_args(argv)
+
+
+def main(argv=None):
+    args = parse_args(argv)
+
+    keymap_path = args.keymap.resolve()
+    keyboard_dir = keymap_path.parents[2]
+
+    defines = {}
+    for define in args.defines:
+        name, _, value = define.partition('=')
+        defines[name] = value or None
+
+    records, cpu_hz, dropped = parse_dump(args.dump.read_text(encoding='utf-8', errors='replace').splitlines())
+    times = unwrap_times(records, cpu_hz)
+    ticks = unwrap_timer(records)
+
+    debounce_config = load_debounce_config([keyboard_dir / 'config.h', keymap_path.parent / 'config.h'])
+    if args.debounce is not None:
+        debounce_config['KKB_DEBOUNCE_START'] = args.debounce
+    debounce_ms = debounce_config['KKB_DEBOUNCE_START']
+
+    print(f"Records: {len(records)} (dropped before dump: {dropped}), CPU: {cpu_hz / 1e6:.1f} MHz")
+    if args.algorithm == 'adaptive':
+        print(f"Debounce: adaptive, start {debounce_ms} ms "
+              f"({debounce_config['KKB_DEBOUNCE_MIN']}-{debounce_config['KKB_DEBOUNCE_MAX']} ms)")
+    else:
+        print(f"Debounce: {args.algorithm}, {debounce_ms} ms")
+    print()
+
+    changes = [(time_us, tick_ms, row, state) for time_us, tick_ms, (_, _, row, state) in zip(times, ticks, records)]
+    events = debounce(changes, debounce_ms, args.algorithm, debounce_config)
+
+    # dip_switch_update_kb(): active (position 0) selects layer 0
+    keymap_data = keymap_cpp.extract_keymap(keymap_path, defines)
+    tap_hold = None if args.no_tap_hold else load_tap_hold_config(keymap_path.parent / 'config.h')
+    if tap_hold and args.tap_hold_flow is not None:
+        tap_hold['flow_ms'] = args.tap_hold_flow
+    if tap_hold and args.tap_hold_term is not None:
+        tap_hold['term_ms'] = args.tap_hold_term
+    if tap_hold:
+        print(f"Tap-hold: flow {tap_hold['flow_ms']} ms, term {tap_hold['term_ms']} ms")
+        print()
+
+    pipeline = Pipeline(keymap_data, load_matrix_map(keyboard_dir / 'keyboard.json'),
+                        load_key_combos(keyboard_dir / 'kkb.c'), args.dip, tap_hold)
+
+    reports = 0
+    for time_us, row, col, pressed in events:
+        key_index = pipeline.matrix_map.get((row, col))
+        action = 'press  ' if pressed else 'release'
+        if key_index is None:
+            print(f"{time_us / 1000:10.3f} ms  {action} [{row},{col}]  (not in layout)")
+            continue
+
+        keycode, description, key_reports = pipeline.process(key_index, pressed, time_us / 1000)
+        print(f"{time_us / 1000:10.3f} ms  {action} [{row},{col}]  {keycode:<14} {description}")
+        for report in key_reports:
+            reports += 1
+            print(f"{'':16}report: {report}")
+
+    print()
+    print(f"Key events: {len(events)}, reports: {reports}")
+
+    if tap_hold:
+        print()
+        print("Tap-hold decision latency (ms):")
+        for line in pipeline.tap_hold_summary():
+            print(f"  {line}")
+
+
+if __name__ == "__main__":
+    main()
@@ -15,6 +15,9 @@ _spec.loader.exec_module(common)
 LAYOUT_NAME = "English (en-us) ANSI"
 LAYOUT_DESCRIPTION = "K7 Pro ISO RGB (69 keys)"
 
+# Defines passed to the preprocessor backend, selects the matching UC_* aliases
+HOST_DEFINES = {'HOST_LAYOUT_US': 1}
+
 # Language-specific key mappings for US ANSI layout
 # Only the keys that differ from Norwegian/European layouts
 LAYOUT_SPECIFIC_KEYS = {
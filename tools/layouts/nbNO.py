@@ -15,6 +15,9 @@ _spec.loader.exec_module(common)
 LAYOUT_NAME = "Norwegian (nb-NO) ISO"
 LAYOUT_DESCRIPTION = "K7 Pro ISO RGB (69 keys)"
 
+# Defines passed to the preprocessor backend, selects the matching UC_* aliases
+HOST_DEFINES = {'HOST_LAYOUT_NORWEGIAN': 1}
+
 # Language-specific key mappings for Norwegian ISO layout
 # Only the keys that differ from US layout
 LAYOUT_SPECIFIC_KEYS = {
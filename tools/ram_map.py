@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+
+# Copyright 2025 kkb (@ktragethon)
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+"""
+Static RAM map from the firmware's linker map file.
+
+Reads the GNU ld map written by the QMK build (.build/kkb_<keymap>.map)
+and prints:
+  - the memory regions and the output sections placed in RAM (data, bss,
+    no-init RAM, the ChibiOS main/process stacks, and the heap left to the
+    core allocator)
+  - the static RAM of every object file, by output section (.data, .bss, ...)
+  - the size, section and object file of given global symbols (by default
+    the keymap tables, which are constants in flash)
+
+Object files are the ones given to the linker: with LTO_ENABLE they are
+LTO partitions, build without it for a per-file breakdown.
+
+Usage:
+    python3 ./tools/ram_map.py
+    python3 ./tools/ram_map.py qmk_firmware/.build/kkb_code1.map --top 15
+    python3 ./tools/ram_map.py --keymap default --symbol keymap_config
+"""
+
+import re
+import sys
+import argparse
+from pathlib import Path
+
+tools_dir = Path(__file__).resolve().parent
+repo_dir = tools_dir.parent
+
+DEFAULT_SYMBOLS = ['g_snled27351_leds', 'keymaps', 'kkb_sparse_keycodes']
+
+REGION_RE = re.compile(r'^(\S+)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s*(\S*)$')
+OUTPUT_RE = re.compile(r'^(\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+))?')
+INPUT_RE = re.compile(r'^ (\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)(?:\s+(.+))?)?$')
+CONTINUATION_RE = re.compile(r'^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)(?:\s+(.+))?$')
+SYMBOL_RE = re.compile(r'^\s+(0x[0-9a-fA-F]+)\s+([A-Za-z_.$][\w.$]*)$')
+ASSIGNMENT_RE = re.compile(r'^\s+(0x[0-9a-fA-F]+)\s+([A-Za-z_]\w*) = ')
+
+
+class MapFile:
+    """Memory regions, output sections, input sections and symbols of a GNU ld map"""
+
+    def __init__(self, path):
+        self.regions = []   # (name, origin, length, attributes)
+        self.outputs = []   # (name, address, size)
+        self.inputs = []    # (output, address, size, object)
+        self.symbols = {}   # name: (address, size, output, object)
+        self.assignments = {}
+        self.parse(Path(path).read_text(encoding='utf-8', errors='replace').splitlines())
+
+    def parse(self, lines):
+        state = None
+        output = None
+        pending = None  # Input or output section name, address on the next line
+        section_symbols = []
+
+        def close_input():
+            # Symbol sizes: up to the next symbol of the input section, or its end
+            if not section_symbols:
+                return
+            _, address, size, obj = self.inputs[-1]
+            for i, (sym_address, name) in enumerate(section_symbols):
+                end = section_symbols[i + 1][0] if i + 1 < len(section_symbols) else address + size
+                self.symbols.setdefault(name, (sym_address, max(end - sym_address, 0), output, obj))
+            section_symbols.clear()
+
+        for line in lines:
+            if line.startswith('Memory Configuration'):
+                state = 'memory'
+                continue
+            if line.startswith('Linker script and memory map'):
+                state = 'map'
+                continue
+            if state == 'memory':
+                match = REGION_RE.match(line)
+                if match and match.group(1) not in ('Name', '*default*'):
+                    self.regions.append((match.group(1), int(match.group(2), 16), int(match.group(3), 16), match.group(4)))
+                continue
+            if state != 'map' or not line.strip():
+                continue
+
+            if pending:
+                match = CONTINUATION_RE.match(line)
+                kind, name = pending
+                pending = None
+                if match:
+                    address, size = int(match.group(1), 16), int(match.group(2), 16)
+                    if kind == 'output':
+                        close_input()
+                        output = name
+                        self.outputs.append((name, address, size))
+                    else:
+                        close_input()
+                        self.inputs.append((output, address, size, object_name(match.group(3))))
+                    continue
+
+            if not line[0].isspace():
+                match = OUTPUT_RE.match(line)
+                if match and match.group(1) not in ('LOAD', 'OUTPUT', 'START', 'END'):
+                    close_input()
+                    if match.group(2):
+                        output = match.group(1)
+                        self.outputs.append((output, int(match.group(2), 16), int(match.group(3), 16)))
+                    else:
+                        pending = ('output', match.group(1))
+                continue
+
+            match = INPUT_RE.match(line)
+            if match and not match.group(1).startswith('*(') and match.group(1) != '*fill*':
+                close_input()
+                if match.group(2) is None:
+                    pending = ('input', match.group(1))
+                else:
+                    self.inputs.append((output, int(match.group(2), 16), int(match.group(3), 16), object_name(match.group(4))))
+                continue
+
+            match = ASSIGNMENT_RE.match(line)
+            if match:
+                self.assignments[match.group(2)] = int(match.group(1), 16)
+                continue
+
+            match = SYMBOL_RE.match(line)
+            if match and self.inputs and self.inputs[-1][0] == output:
+                section_symbols.append((int(match.group(1), 16), match.group(2)))
+
+        close_input()
+
+    def in_ram(self, address):
+        return any('w' in attributes.lower() and origin <= address < origin + length
+                   for _, origin, length, attributes in self.regions)
+
+
+def object_name(text):
+    """Object file name without the build path, archive members as lib.a(member.o)"""
+    if not text:
+        return '(linker)'
+    text = text.strip()
+    match = re.match(r'(.*?)([^/\\]+\.a)\((.+)\)$', text)
+    if match:
+        return f"{match.group(2)}({match.group(3)})"
+    return Path(text).name
+
+
+def parse_args(argv=None):
+    parser = argparse.ArgumentParser(description="Static RAM map by object file, from the linker map")
+    parser.add_argument('map', type=Path, nargs='?', help="Linker map (default: qmk_firmware/.build/kkb_<keymap>.map)")
+    parser.add_argument('--keymap', default='code1', help="Keymap, for the default map file (default: code1)")
+    parser.add_argument('--top', type=int, default=0, help="Object files listed, largest first (default: all)")
+    parser.add_argument('--symbol', action='append', default=[], help="Also report this symbol (repeatable)")
+    return parser.parse_args(argv)
+
+
+def main(argv=None):
+    args = parse_args(argv)
+    path = args.map or repo_dir / 'qmk_firmware' / '.build' / f'kkb_{args.keymap}.map'
+    if not path.is_file():
+        print(f"Error: map file '{path}' not found (build the firmware first)")
+        sys.exit(1)
+
+    memory = MapFile(path)
+    if not memory.regions:
+        print(f"Error: no memory regions in '{path}'")
+        sys.exit(1)
+
+    print(f"RAM map: {path.name}")
+    print()
+    print("Memory regions:")
+    for name, origin, length, attributes in memory.regions:
+        print(f"  {name:<16} 0x{origin:08X} {length:>8} bytes  {attributes}")
+
+    ram_outputs = [(name, address, size) for name, address, size in memory.outputs if size and memory.in_ram(address)]
+    print()
+    print("RAM sections:")
+    for name, address, size in sorted(ram_outputs, key=lambda output: output[1]):
+        print(f"  {name:<16} 0x{address:08X} {size:>8} bytes")
+
+    # The heap gets the RAM left over (ChibiOS core allocator)
+    heap_base = memory.assignments.get('__heap_base__')
+    static = sum(size for _, address, size in ram_outputs if address != heap_base)
+    print(f"  {'total (static)':<16} {'':10} {static:>8} bytes")
+    if heap_base is not None and '__heap_end__' in memory.assignments:
+        print(f"  {'heap (free)':<16} 0x{heap_base:08X} {memory.assignments['__heap_end__'] - heap_base:>8} bytes")
+
+    # Static RAM by object file and output section
+    columns = [name for name, _, _ in sorted(ram_outputs, key=lambda output: output[1])
+               if any(output == name and size for output, _, size, _ in memory.inputs)]
+    objects = {}
+    for output, address, size, obj in memory.inputs:
+        if output in columns and size:
+            objects.setdefault(obj, dict.fromkeys(columns, 0))[output] += size
+
+    rows = sorted(objects.items(), key=lambda item: -sum(item[1].values()))
+    if args.top:
+        rows = rows[:args.top]
+    width = max([len(obj) for obj, _ in rows] + [16])
+    print()
+    print("Static RAM by object file (bytes):")
+    print(f"  {'object':<{width}} " + ' '.join(f"{column:>10}" for column in columns) + f" {'total':>8}")
+    for obj, sizes in rows:
+        print(f"  {obj:<{width}} " + ' '.join(f"{sizes[column]:>10}" for column in columns) + f" {sum(sizes.values()):>8}")
+
+    print()
+    print("Symbols:")
+    for name in DEFAULT_SYMBOLS + args.symbol:
+        if name not in memory.symbols:
+            print(f"  {name:<24} (not found)")
+            continue
+        address, size, output, obj = memory.symbols[name]
+        where = 'RAM' if memory.in_ram(address) else 'flash'
+        print(f"  {name:<24} {size:>6} bytes  {where:<5} {output:<12} {obj}")
+
+
+if __name__ == "__main__":
+    main()